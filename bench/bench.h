@@ -0,0 +1,28 @@
+#ifndef STRUCTZ_BENCH_H
+#define STRUCTZ_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+// Wall-clock seconds of the fastest of `runs` calls to `body`.
+template<typename F>
+double best_seconds(const int runs, F&& body) {
+    double best = 0;
+
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+
+    return best;
+}
+
+inline void report(const char* const name, const double seconds) {
+    std::printf("%-32s %10.2f ms\n", name, seconds * 1000);
+}
+
+#endif
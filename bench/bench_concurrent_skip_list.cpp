@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "avl_tree.h"
+#include "bench.h"
+#include "concurrent_skip_list.h"
+
+// Throughput of a mixed workload, 80% lookups, 10% inserts and 10% removals over 2^20 keys,
+// on a ConcurrentSkipList and on an AvlTree behind one std::mutex, for a growing number of
+// threads. Each thread performs the same number of operations.
+namespace {
+    constexpr int KEYS = 1 << 20;
+    constexpr int OPS_PER_THREAD = 500000;
+
+    class LockedAvlTree {
+        AvlTree<int, int> m_tree;
+        std::mutex m_mutex;
+
+    public:
+        bool contains(const int key) {
+            const std::lock_guard lock(m_mutex);
+            return m_tree.contains(key);
+        }
+
+        bool insert(const int key, const int value) {
+            const std::lock_guard lock(m_mutex);
+            return m_tree.insert(key, value);
+        }
+
+        bool remove(const int key) {
+            const std::lock_guard lock(m_mutex);
+            return m_tree.remove(key);
+        }
+    };
+
+    // Returns the number of keys found, so that the lookups cannot be optimized away.
+    template<typename Map>
+    std::uint64_t run(Map& map, const unsigned thread_id) {
+        std::mt19937 rng(thread_id + 1);
+        std::uniform_int_distribution<int> key(0, KEYS - 1);
+        std::uniform_int_distribution<int> op(0, 9);
+        std::uint64_t found = 0;
+
+        for (int i = 0; i < OPS_PER_THREAD; ++i) {
+            const int k = key(rng);
+
+            switch (op(rng)) {
+                case 0:
+                    map.insert(k, i);
+                    break;
+                case 1:
+                    map.remove(k);
+                    break;
+                default:
+                    found += map.contains(k) ? 1 : 0;
+                    break;
+            }
+        }
+
+        return found;
+    }
+
+    // Operations per second over all threads, best of three runs, each on a freshly filled map.
+    template<typename Map>
+    double throughput(const unsigned threads) {
+        double best = 0;
+        std::atomic<std::uint64_t> found{0};
+
+        for (int run_index = 0; run_index < 3; ++run_index) {
+            Map map;
+            for (int k = 0; k < KEYS; k += 2)
+                map.insert(k, k);
+
+            const double seconds = best_seconds(1, [&] {
+                std::vector<std::thread> workers;
+
+                for (unsigned t = 0; t < threads; ++t)
+                    workers.emplace_back([&map, &found, t] { found += run(map, t); });
+
+                for (auto& worker : workers)
+                    worker.join();
+            });
+
+            best = std::max(best, threads * static_cast<double>(OPS_PER_THREAD) / seconds);
+        }
+
+        return best;
+    }
+}
+
+int main() {
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    for (const unsigned threads : {1u, 2u, 4u, 8u}) {
+        std::printf("%u threads (Mops/s)\n", threads);
+        std::printf("  %-30s %8.2f\n", "ConcurrentSkipList",
+                    throughput<ConcurrentSkipList<int, int>>(threads) / 1e6);
+        std::printf("  %-30s %8.2f\n", "AvlTree + std::mutex",
+                    throughput<LockedAvlTree>(threads) / 1e6);
+    }
+
+    return 0;
+}
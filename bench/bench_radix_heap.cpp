@@ -0,0 +1,118 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <utility>
+#include "bench.h"
+#include "binary_heap.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+#include "vec.h"
+
+// Dijkstra from vertex 0 of a random sparse graph, with a RadixHeap, and with a BinaryHeap and a
+// PairingHeap of (distance, vertex) pairs. All use lazy deletion.
+namespace {
+    constexpr std::uint32_t VERTICES = 1 << 20;
+    constexpr std::uint32_t EDGES_PER_VERTEX = 4;
+    constexpr std::uint64_t INFINITY_DIST = std::numeric_limits<std::uint64_t>::max();
+
+    struct Edge {
+        std::uint32_t to = 0;
+        std::uint32_t weight = 0;
+    };
+
+    // Adjacency in compressed rows: the edges of v are edges[v * EDGES_PER_VERTEX, ...).
+    Vec<Edge> random_graph() {
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<std::uint32_t> vertex(0, VERTICES - 1);
+        std::uniform_int_distribution<std::uint32_t> weight(1, 1000000);
+
+        Vec<Edge> edges(VERTICES * EDGES_PER_VERTEX);
+
+        for (std::uint32_t v = 0; v < VERTICES; ++v) {
+            // A ring edge keeps every vertex reachable.
+            edges[v * EDGES_PER_VERTEX] = {(v + 1) % VERTICES, weight(rng)};
+
+            for (std::uint32_t e = 1; e < EDGES_PER_VERTEX; ++e)
+                edges[v * EDGES_PER_VERTEX + e] = {vertex(rng), weight(rng)};
+        }
+
+        return edges;
+    }
+
+    template<typename Push, typename Pop, typename IsEmpty>
+    std::uint64_t dijkstra(const Vec<Edge>& edges, Push&& push, Pop&& pop, IsEmpty&& is_empty) {
+        Vec<std::uint64_t> dist(VERTICES);
+        for (auto& d : dist)
+            d = INFINITY_DIST;
+
+        dist[0] = 0;
+        push(0, 0);
+
+        while (!is_empty()) {
+            const auto [d, v] = pop();
+            if (d != dist[v])
+                continue;
+
+            for (std::uint32_t e = 0; e < EDGES_PER_VERTEX; ++e) {
+                const Edge& edge = edges[v * EDGES_PER_VERTEX + e];
+
+                if (d + edge.weight < dist[edge.to]) {
+                    dist[edge.to] = d + edge.weight;
+                    push(dist[edge.to], edge.to);
+                }
+            }
+        }
+
+        std::uint64_t checksum = 0;
+        for (const auto d : dist)
+            checksum += d;
+
+        return checksum;
+    }
+}
+
+int main() {
+    const Vec<Edge> edges = random_graph();
+    std::uint64_t radix_sum = 0;
+    std::uint64_t binary_sum = 0;
+    std::uint64_t pairing_sum = 0;
+
+    const double radix = best_seconds(3, [&] {
+        RadixHeap<std::uint64_t, std::uint32_t> heap;
+
+        radix_sum = dijkstra(
+            edges,
+            [&](const std::uint64_t d, const std::uint32_t v) { heap.push(d, v); },
+            [&] { return heap.pop(); },
+            [&] { return heap.is_empty(); });
+    });
+
+    const double binary = best_seconds(3, [&] {
+        BinaryHeap<std::pair<std::uint64_t, std::uint32_t>> heap;
+
+        binary_sum = dijkstra(
+            edges,
+            [&](const std::uint64_t d, const std::uint32_t v) { heap.push({d, v}); },
+            [&] { return heap.pop(); },
+            [&] { return heap.is_empty(); });
+    });
+
+    const double pairing = best_seconds(3, [&] {
+        PairingHeap<std::pair<std::uint64_t, std::uint32_t>> heap;
+
+        pairing_sum = dijkstra(
+            edges,
+            [&](const std::uint64_t d, const std::uint32_t v) { heap.push({d, v}); },
+            [&] { return heap.pop(); },
+            [&] { return heap.is_empty(); });
+    });
+
+    std::printf("Dijkstra, %u vertices, %u edges\n", VERTICES, VERTICES * EDGES_PER_VERTEX);
+    report("RadixHeap", radix);
+    report("BinaryHeap", binary);
+    report("PairingHeap", pairing);
+
+    return radix_sum == binary_sum && binary_sum == pairing_sum ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "avl_tree.h"
+#include "bench.h"
+#include "bs_tree.h"
+#include "splay_tree.h"
+
+// Lookups of 2^20 keys, inserted in random order, where the key of popularity rank r is asked
+// for with probability proportional to r^-s. s = 0 is uniform; larger s is more skewed.
+namespace {
+    constexpr int KEYS = 1 << 20;
+    constexpr int LOOKUPS = 2000000;
+
+    template<typename Tree>
+    std::uint64_t look_up(Tree& tree, const std::vector<int>& lookups) {
+        std::uint64_t sum = 0;
+
+        for (const int key : lookups)
+            sum += static_cast<std::uint64_t>(tree.get(key));
+
+        return sum;
+    }
+}
+
+int main() {
+    std::vector<int> keys(KEYS);
+    for (int i = 0; i < KEYS; ++i)
+        keys[i] = i;
+
+    std::mt19937 rng(1);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    SplayTree<int, int> splay;
+    AvlTree<int, int> avl;
+    BSTree<int, int> bst;
+
+    for (const int key : keys) {
+        splay.insert(key, key);
+        avl.insert(key, key);
+        bst.insert(key, key);
+    }
+
+    for (const double skew : {0.0, 1.0, 1.5}) {
+        std::vector<double> weights(KEYS);
+        for (int i = 0; i < KEYS; ++i)
+            weights[i] = std::pow(i + 1.0, -skew);
+
+        std::discrete_distribution<int> rank(weights.begin(), weights.end());
+        std::vector<int> lookups(LOOKUPS);
+
+        for (int& key : lookups)
+            key = keys[rank(rng)];
+
+        std::uint64_t sums[3] = {};
+
+        std::printf("%d lookups, s = %.1f\n", LOOKUPS, skew);
+        report("SplayTree", best_seconds(3, [&] { sums[0] = look_up(splay, lookups); }));
+        report("AvlTree", best_seconds(3, [&] { sums[1] = look_up(avl, lookups); }));
+        report("BSTree", best_seconds(3, [&] { sums[2] = look_up(bst, lookups); }));
+
+        if (sums[0] != sums[1] || sums[1] != sums[2])
+            return 1;
+    }
+
+    return 0;
+}
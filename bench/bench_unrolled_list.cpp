@@ -0,0 +1,48 @@
+#include <cstdint>
+#include <cstdio>
+#include "bench.h"
+#include "doubly_linked_list.h"
+#include "unrolled_list.h"
+#include "vec.h"
+
+// Sums 10M ints held in a Vec, in an UnrolledList walked by iterator and by for_each(), and in a
+// DoublyLinkedList. Every container is filled with push_back() alone.
+namespace {
+    constexpr int COUNT = 10000000;
+
+    template<typename Container>
+    std::int64_t sum(const Container& container) {
+        std::int64_t total = 0;
+
+        for (const int value : container)
+            total += value;
+
+        return total;
+    }
+}
+
+int main() {
+    Vec<int> vec;
+    UnrolledList<int> unrolled;
+    DoublyLinkedList<int> doubly;
+
+    for (int i = 0; i < COUNT; ++i) {
+        vec.push(i);
+        unrolled.push_back(i);
+        doubly.push_back(i);
+    }
+
+    std::int64_t sums[4] = {};
+
+    std::printf("Summing %d ints\n", COUNT);
+    report("Vec", best_seconds(5, [&] { sums[0] = sum(vec); }));
+    report("UnrolledList iterator", best_seconds(5, [&] { sums[1] = sum(unrolled); }));
+    report("UnrolledList for_each", best_seconds(5, [&] {
+        std::int64_t total = 0;
+        unrolled.for_each([&](const int value) { total += value; });
+        sums[2] = total;
+    }));
+    report("DoublyLinkedList", best_seconds(5, [&] { sums[3] = sum(doubly); }));
+
+    return sums[0] == sums[1] && sums[1] == sums[2] && sums[2] == sums[3] ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#ifndef STRUCTZ_AHO_CORASICK_H
+#define STRUCTZ_AHO_CORASICK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "trie.h"
+#include "vec.h"
+
+// Multi-pattern matcher compiled from the words of a Trie. The automaton is a dense DFA over byte
+// classes (bytes that appear in no pattern share one class), so scanning costs one table lookup
+// per input byte regardless of the number of patterns. Empty words are ignored.
+class AhoCorasick {
+public:
+    struct Match {
+        std::size_t start;
+        std::size_t pattern;
+
+        bool operator==(const Match& other) const {
+            return start == other.start && pattern == other.pattern;
+        }
+
+        bool operator!=(const Match& other) const {
+            return !(*this == other);
+        }
+    };
+
+private:
+    using State = std::uint32_t;
+
+    static constexpr State NONE = UINT32_MAX;
+
+    Vec<std::string> m_patterns;
+    std::array<std::uint16_t, 256> m_classes{};
+    std::size_t m_class_count = 1;
+
+    Vec<State> m_delta;         // m_delta[state * m_class_count + class]
+    Vec<State> m_output;        // Pattern ending exactly at each state, or NONE.
+    Vec<State> m_first_report;  // The state itself if it has an output, else its dictionary link.
+    Vec<State> m_next_report;   // Nearest proper suffix state with an output, or NONE.
+
+    [[nodiscard]] State next(const State state, const char ch) const {
+        return m_delta[(state * m_class_count) + m_classes[static_cast<unsigned char>(ch)]];
+    }
+
+public:
+    explicit AhoCorasick(const Trie& patterns);
+
+    [[nodiscard]] std::size_t pattern_count() const;
+
+    [[nodiscard]] const std::string& pattern(std::size_t id) const;
+
+    [[nodiscard]] std::size_t state_count() const;
+
+    // Calls `on_match(Match)` for every occurrence of every pattern, in order of end position.
+    template<typename F>
+    void for_each_match(const std::string_view text, F&& on_match) const {
+        State state = 0;
+
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            state = next(state, text[i]);
+
+            for (State s = m_first_report[state]; s != NONE; s = m_next_report[s]) {
+                const State id = m_output[s];
+                on_match(Match{i + 1 - m_patterns[id].size(), id});
+            }
+        }
+    }
+
+    [[nodiscard]] Vec<Match> find_all(std::string_view text) const;
+
+    [[nodiscard]] bool contains_any(std::string_view text) const;
+};
+
+#endif
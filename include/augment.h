@@ -0,0 +1,94 @@
+#ifndef STRUCTZ_AUGMENT_H
+#define STRUCTZ_AUGMENT_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+// Augmentation policies for the balanced binary search trees. Every node inherits from
+// `Policy::Data` (so an empty Data costs nothing), and the tree calls
+//
+//     Policy::update(data, key, value, left, right)
+//
+// whenever a node or one of its subtrees changes; `left` and `right` point to the children's
+// Data, or are null for missing children. Any per-subtree aggregate (sum, min, max...) can be
+// maintained this way.
+
+struct NoAugment {
+    struct Data {};
+
+    template<typename K, typename T>
+    static void update(Data&, const K&, const T&, const Data*, const Data*) {}
+};
+
+// Subtree sizes, which enable rank(), select() and count_range() in O(log n).
+struct SubtreeSize {
+    struct Data {
+        std::size_t size = 1;
+    };
+
+    template<typename K, typename T>
+    static void update(Data& data,
+                       const K&,
+                       const T&,
+                       const Data* const left,
+                       const Data* const right) {
+        data.size = 1 + (left != nullptr ? left->size : 0) + (right != nullptr ? right->size : 0);
+    }
+};
+
+namespace augment_detail {
+    template<typename Data, typename = void>
+    struct has_size : std::false_type {};
+
+    template<typename Data>
+    struct has_size<Data, std::void_t<decltype(std::declval<const Data&>().size)>>
+        : std::true_type {};
+
+    template<typename Node>
+    [[nodiscard]] std::size_t size(const Node* const node) {
+        return node != nullptr ? node->size : 0;
+    }
+
+    // Number of keys less than `key` (or not greater, if `inclusive`).
+    template<typename Node, typename K, typename Compare>
+    [[nodiscard]] std::size_t count_less(const Node* node,
+                                         const K& key,
+                                         const bool inclusive,
+                                         const Compare& cmp) {
+        std::size_t count = 0;
+
+        while (node != nullptr) {
+            if (inclusive ? cmp(key, node->key) : !cmp(node->key, key)) {
+                node = node->left;
+            } else {
+                count += size(node->left) + 1;
+                node = node->right;
+            }
+        }
+
+        return count;
+    }
+
+    template<typename Node>
+    [[nodiscard]] const Node* select(const Node* node, std::size_t index) {
+        if (index >= size(node))
+            throw std::out_of_range("Index out of bounds");
+
+        while (true) {
+            const std::size_t left = size(node->left);
+
+            if (index == left)
+                return node;
+
+            if (index < left) {
+                node = node->left;
+            } else {
+                index -= left + 1;
+                node = node->right;
+            }
+        }
+    }
+}
+
+#endif
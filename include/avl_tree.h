@@ -2,109 +2,422 @@
 #define STRUCTZ_AVL_TREE_H
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
-#include <cstdlib>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
-#include "stack.h"
+#include "augment.h"
+#include "binary_io.h"
+#include "compare.h"
+#include "join.h"
+#include "tagged_ptr.h"
 #include "vec.h"
 
-template<typename K, typename T, typename Compare = std::less<K>>
+// Nodes store a balance factor (-1, 0 or +1) in the two low bits of their right child pointer
+// instead of a height, so rebalancing never has to load the children to compare their heights.
+//
+// `Augment` maintains per-subtree data (see augment.h). With SubtreeSize, the tree also supports
+// rank(), select() and count_range().
+template<typename K, typename T, typename Compare = std::less<K>, typename Augment = NoAugment>
 class AvlTree {
-    struct Node {
+    using Data = typename Augment::Data;
+
+    static constexpr bool AUGMENTED = !std::is_empty_v<Data>;
+
+    // Index of a child: left (0) or right (1).
+    using Dir = unsigned char;
+
+    struct Node : Data {
         K key;
         T value;
-        std::size_t height;
         Node* left = nullptr;
-        Node* right = nullptr;
+        TaggedPtr<Node, 2> right;  // Tagged with the balance factor plus one.
 
-        explicit Node(K key, T value, const std::size_t height)
+        explicit Node(K key, T value, const int balance = 0)
             : key(std::move(key)),
               value(std::move(value)),
-              height(height) {}
+              right(nullptr, static_cast<unsigned>(balance + 1)) {}
+    };
+
+    // Holds for every K and T: the node contains a pointer, and operator new aligns it.
+    static_assert(alignof(Node) >= 4, "the balance factor needs two free pointer bits");
+
+    // An AVL tree of height h has at least fib(h + 3) - 1 nodes, so it is never higher than
+    // 1.44 log2(n + 2).
+    static constexpr std::size_t MAX_DEPTH = 3 * std::numeric_limits<std::size_t>::digits / 2;
+
+    // Ancestors of the node being inserted or removed and the direction taken at each of them,
+    // kept inline so updates allocate nothing besides the node itself.
+    class Path {
+        std::array<std::pair<Node*, Dir>, MAX_DEPTH> m_entries;
+        std::size_t m_depth = 0;
+
+    public:
+        void push(const std::pair<Node*, Dir> entry) {
+            m_entries[m_depth++] = entry;
+        }
+
+        std::pair<Node*, Dir> pop() {
+            return m_entries[--m_depth];
+        }
+
+        [[nodiscard]] const std::pair<Node*, Dir>& top() const {
+            return m_entries[m_depth - 1];
+        }
+
+        [[nodiscard]] bool is_empty() const {
+            return m_depth == 0;
+        }
     };
 
     std::size_t m_size = 0;
     Node* m_root = nullptr;
     Compare cmp{};
 
-    [[nodiscard]] static std::ptrdiff_t bf(Node* const node) {
-        return height(node->right) - height(node->left);
+    // Height of the right subtree minus height of the left one.
+    [[nodiscard]] static int balance(const Node* const node) {
+        return static_cast<int>(node->right.tag()) - 1;
     }
 
-    [[nodiscard]] static std::ptrdiff_t height(Node* const node) {
-        if (node == nullptr)
-            return -1;
+    static void set_balance(Node* const node, const int balance) {
+        node->right.set_tag(static_cast<unsigned>(balance + 1));
+    }
 
-        return node->height;
+    [[nodiscard]] static Node* child(const Node* const node, const Dir dir) {
+        return dir == 0 ? node->left : node->right.get();
     }
 
-    constexpr static void update_height(Node* const node) {
-        node->height = 1 + std::max(height(node->left), height(node->right));
+    static void set_child(Node* const node, const Dir dir, Node* const child) {
+        if (dir == 0)
+            node->left = child;
+        else
+            node->right = child;
     }
 
-    static void rotate_left(Node*& x) {
+    template<typename Self>
+    static auto* find_node(Self& self, const K& key) {
+        auto* cur = self.m_root;
+
+        while (cur != nullptr) {
+            const int order = three_way(self.cmp, key, cur->key);
+
+            if (order == 0)
+                return cur;
+
+            cur = child(cur, order > 0);
+        }
+
+        return cur;
+    }
+
+    // Recomputes the augmented data of a node from its children.
+    static void update(Node* const node) {
+        Augment::update(static_cast<Data&>(*node), node->key, node->value, node->left, node->right);
+    }
+
+    // Rotates `x` down towards `dir`; its child on the other side takes its place. Balance
+    // factors are left to the caller.
+    static void rotate(Node*& x, const Dir dir) {
         Node* const x_prev = x;
-        Node* const z = x_prev->right;
+        Node* const z = child(x_prev, !dir);
 
         x = z;
-        x_prev->right = z->left;
-        z->left = x_prev;
+        set_child(x_prev, !dir, child(z, dir));
+        set_child(z, dir, x_prev);
 
-        update_height(x_prev);
-        update_height(z);
+        update(x_prev);
+        update(z);
     }
 
-    static void rotate_right(Node*& x) {
+    // Restores balance at `x`, whose `heavy` side has become two levels taller than the other.
+    // Returns whether the subtree ends up shorter than before the rotation, which only matters
+    // when removing.
+    static bool rebalance(Node*& x, const Dir heavy) {
+        const int sign = heavy == 0 ? -1 : 1;
+        Node* const z = child(x, heavy);
+        const int z_balance = balance(z);
+
+        if (z_balance == -sign) {
+            // The inner grandchild is the tall one: rotate it up twice.
+            Node* const y = child(z, !heavy);
+            const int y_balance = balance(y);
+
+            Node* top = z;
+            rotate(top, heavy);
+            set_child(x, heavy, top);
+
+            Node* const x_prev = x;
+            rotate(x, !heavy);
+
+            set_balance(x_prev, y_balance == sign ? -sign : 0);
+            set_balance(z, y_balance == -sign ? sign : 0);
+            set_balance(y, 0);
+            return true;
+        }
+
         Node* const x_prev = x;
-        Node* const z = x_prev->left;
+        rotate(x, !heavy);
 
-        x = z;
-        x_prev->left = z->right;
-        z->right = x_prev;
+        if (z_balance == 0) {
+            set_balance(x_prev, sign);
+            set_balance(z, -sign);
+            return false;
+        }
+
+        set_balance(x_prev, 0);
+        set_balance(z, 0);
+        return true;
+    }
+
+    // Makes `node` the child of the last node on `path`, or the root if the path is empty.
+    void link(const Path& path, Node* const node) {
+        if (path.is_empty())
+            m_root = node;
+        else
+            set_child(path.top().first, path.top().second, node);
+    }
+
+    // Builds a balanced tree out of entries[first, last), which must be sorted by key, and stores
+    // its height in `height`.
+    static Node* build(Vec<std::pair<K, T>>& entries,
+                       const std::size_t first,
+                       const std::size_t last,
+                       std::ptrdiff_t& height) {
+        if (first == last) {
+            height = -1;
+            return nullptr;
+        }
+
+        const std::size_t mid = first + (last - first) / 2;
+        std::ptrdiff_t left_height = 0;
+        std::ptrdiff_t right_height = 0;
+
+        Node* const left = build(entries, first, mid, left_height);
+        Node* const node = new Node(std::move(entries[mid].first), std::move(entries[mid].second));
+
+        node->left = left;
+        node->right = build(entries, mid + 1, last, right_height);
+        set_balance(node, static_cast<int>(right_height - left_height));
+        update(node);
+
+        height = 1 + std::max(left_height, right_height);
+        return node;
+    }
+
+    // Hooks for the join-based operations (see join.h). A subtree's rank is its height.
+    friend struct join_detail::Algorithms<AvlTree>;
+    using Join = join_detail::Algorithms<AvlTree>;
+
+    struct Subtree {
+        Node* root = nullptr;
+        std::ptrdiff_t rank = -1;
+    };
+
+    // Height of the `dir` child of a node whose height is `height`.
+    [[nodiscard]] static std::ptrdiff_t child_height(const Node* const node,
+                                                     const std::ptrdiff_t height,
+                                                     const Dir dir) {
+        const int taller = dir == 0 ? -1 : 1;
+        return balance(node) == -taller ? height - 2 : height - 1;
+    }
+
+    static void expose(const Subtree& tree, Subtree& left, Subtree& right) {
+        left = {tree.root->left, child_height(tree.root, tree.rank, 0)};
+        right = {tree.root->right.get(), child_height(tree.root, tree.rank, 1)};
+    }
+
+    // Hangs `left` and `right` below `node`. Their heights may differ by up to two, in which case
+    // the result is rotated back into balance.
+    static Subtree attach(Node* const node, const Subtree& left, const Subtree& right) {
+        const std::ptrdiff_t diff = right.rank - left.rank;
+
+        if (diff > 1 || diff < -1) {
+            const Dir heavy = diff > 0 ? 1 : 0;
+            const Subtree& tall = heavy == 1 ? right : left;
+
+            Subtree tall_left;
+            Subtree tall_right;
+            expose(tall, tall_left, tall_right);
+
+            const Subtree& outer = heavy == 1 ? tall_right : tall_left;
+            const Subtree& inner = heavy == 1 ? tall_left : tall_right;
+
+            if (outer.rank >= inner.rank) {
+                if (heavy == 1)
+                    return attach(tall.root, attach(node, left, inner), outer);
+
+                return attach(tall.root, outer, attach(node, inner, right));
+            }
+
+            Subtree inner_left;
+            Subtree inner_right;
+            expose(inner, inner_left, inner_right);
+
+            if (heavy == 1)
+                return attach(inner.root,
+                              attach(node, left, inner_left),
+                              attach(tall.root, inner_right, outer));
+
+            return attach(inner.root,
+                          attach(tall.root, outer, inner_left),
+                          attach(node, inner_right, right));
+        }
+
+        node->left = left.root;
+        node->right = right.root;
+        set_balance(node, static_cast<int>(diff));
+        update(node);
 
-        update_height(x_prev);
-        update_height(z);
+        return {node, 1 + std::max(left.rank, right.rank)};
     }
 
-    static void rebalance(Node*& x) {
-        Node* const z = height(x->left) > height(x->right) ? x->left : x->right;
+    static Subtree join(const Subtree& left, Node* const node, const Subtree& right) {
+        if (left.rank > right.rank + 1) {
+            Subtree left_left;
+            Subtree left_right;
+            expose(left, left_left, left_right);
+            return attach(left.root, left_left, join(left_right, node, right));
+        }
+
+        if (right.rank > left.rank + 1) {
+            Subtree right_left;
+            Subtree right_right;
+            expose(right, right_left, right_right);
+            return attach(right.root, join(left, node, right_left), right_right);
+        }
+
+        return attach(node, left, right);
+    }
 
-        if (z == x->right) {
-            if (bf(z) < 0)
-                rotate_right(x->right);
+    static void destroy(Node* const root) {
+        Vec<Node*> stack;
+        stack.push(root);
 
-            rotate_left(x);
-        } else if (z == x->left) {
-            if (bf(z) > 0)
-                rotate_left(x->left);
+        while (!stack.is_empty()) {
+            Node* const node = stack.pop();
+            if (node == nullptr)
+                continue;
 
-            rotate_right(x);
+            stack.push(node->left);
+            stack.push(node->right.get());
+            delete node;
         }
     }
 
+    [[nodiscard]] Subtree whole() const {
+        return {m_root, height()};
+    }
+
+    // Takes over the nodes of `tree`, which hold `size` entries.
+    void assign(const Subtree& tree, const std::size_t size) {
+        m_root = tree.root;
+        m_size = size;
+    }
+
     void swap(AvlTree& other) noexcept {
         std::swap(m_root, other.m_root);
         std::swap(m_size, other.m_size);
     }
 
+    // In-order iterator over (key, value) pairs.
+    template<bool IsConst>
+    class basic_iterator {
+        using node_pointer = std::conditional_t<IsConst, const Node*, Node*>;
+        using mapped_type = std::conditional_t<IsConst, const T, T>;
+
+        Vec<node_pointer> m_stack;
+
+        void push_left(node_pointer node) {
+            while (node != nullptr) {
+                m_stack.push(node);
+                node = node->left;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const K&, mapped_type&>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        basic_iterator() = default;
+
+        explicit basic_iterator(const node_pointer root) {
+            push_left(root);
+        }
+
+        [[nodiscard]] const K& key() const {
+            return m_stack.last()->key;
+        }
+
+        [[nodiscard]] mapped_type& value() const {
+            return m_stack.last()->value;
+        }
+
+        value_type operator*() const {
+            return {key(), value()};
+        }
+
+        basic_iterator& operator++() {
+            const node_pointer node = m_stack.pop();
+            push_left(node->right.get());
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            if (m_stack.is_empty() || other.m_stack.is_empty())
+                return m_stack.is_empty() && other.m_stack.is_empty();
+
+            return m_stack.last() == other.m_stack.last();
+        }
+
+        bool operator!=(const basic_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
 public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // Memory taken by each entry, excluding allocator overhead.
+    static constexpr std::size_t NODE_SIZE = sizeof(Node);
+
     AvlTree() = default;
 
     AvlTree(const AvlTree& other)
         : m_size(other.m_size) {
-        Stack<std::pair<Node**, Node*>> stack;
-        stack.push({&m_root, other.m_root});
+        // Each entry is a node to copy and the parent (and side) it hangs from.
+        Vec<std::tuple<Node*, Dir, const Node*>> stack;
+        stack.push({nullptr, 0, other.m_root});
 
         while (!stack.is_empty()) {
-            const auto [dest, src] = stack.pop();
+            const auto [parent, dir, src] = stack.pop();
             if (src == nullptr)
                 continue;
 
-            *dest = new Node(src->key, src->value, src->height);
-            stack.push({&(*dest)->left, src->left});
-            stack.push({&(*dest)->right, src->right});
+            Node* const node = new Node(src->key, src->value, balance(src));
+            static_cast<Data&>(*node) = *src;
+
+            if (parent == nullptr)
+                m_root = node;
+            else
+                set_child(parent, dir, node);
+
+            stack.push({node, 0, src->left});
+            stack.push({node, 1, src->right.get()});
         }
     }
 
@@ -113,19 +426,7 @@ public:
     }
 
     ~AvlTree() {
-        Vec<Node*> stack;
-        stack.push(std::exchange(m_root, nullptr));
-
-        while (!stack.is_empty()) {
-            Node* const node = stack.pop();
-            if (node == nullptr)
-                continue;
-
-            stack.push(node->left);
-            stack.push(node->right);
-            delete node;
-        }
-
+        destroy(std::exchange(m_root, nullptr));
         m_size = 0;
     }
 
@@ -147,71 +448,145 @@ public:
         return m_size == 0;
     }
 
-    [[nodiscard]] constexpr std::ptrdiff_t height() const {
-        return height(m_root);
+    // Follows the taller child at every level, so this is O(log n).
+    [[nodiscard]] std::ptrdiff_t height() const {
+        std::ptrdiff_t result = -1;
+
+        for (const Node* cur = m_root; cur != nullptr; cur = child(cur, balance(cur) > 0))
+            ++result;
+
+        return result;
     }
 
-    [[nodiscard]] const T& get(const K& key) const {
-        Node* cur = m_root;
+    // Checks ordering and that every stored balance factor matches the subtree heights. Runs
+    // iteratively in O(n) time, so it is safe on trees of any size and shape.
+    [[nodiscard]] bool check_properties() const {
+        // A node still to be checked, or whose children have been checked once `done` is set,
+        // and the nodes its key must lie strictly between.
+        struct Frame {
+            const Node* node;
+            const Node* lower;
+            const Node* upper;
+            bool done;
+        };
 
-        while (cur != nullptr) {
-            if (cur->key == key)
-                return cur->value;
+        Vec<Frame> stack;
+        stack.push({m_root, nullptr, nullptr, false});
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
+        // Results for the subtrees checked so far; a left subtree's comes before its sibling's.
+        Vec<std::ptrdiff_t> heights;
+
+        while (!stack.is_empty()) {
+            const Frame frame = stack.pop();
+            const Node* const node = frame.node;
+
+            if (node == nullptr) {
+                heights.push(-1);
+                continue;
+            }
+
+            if (frame.done) {
+                const std::ptrdiff_t right_height = heights.pop();
+                const std::ptrdiff_t left_height = heights.pop();
+
+                if (right_height - left_height != balance(node))
+                    return false;
+
+                heights.push(1 + std::max(left_height, right_height));
+                continue;
+            }
+
+            if (frame.lower != nullptr && !cmp(frame.lower->key, node->key))
+                return false;
+
+            if (frame.upper != nullptr && !cmp(node->key, frame.upper->key))
+                return false;
+
+            stack.push({node, frame.lower, frame.upper, true});
+            stack.push({node->right.get(), node, frame.upper, false});
+            stack.push({node->left, frame.lower, node, false});
         }
 
-        throw std::out_of_range("key not found");
+        return true;
     }
 
-    [[nodiscard]] T& get(const K& key) {
-        Node* cur = m_root;
+    [[nodiscard]] const T& get(const K& key) const {
+        const Node* const node = find_node(*this, key);
 
-        while (cur != nullptr) {
-            if (cur->key == key)
-                return cur->value;
+        if (node == nullptr)
+            throw std::out_of_range("key not found");
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
-        }
+        return node->value;
+    }
 
-        throw std::out_of_range("key not found");
+    [[nodiscard]] T& get(const K& key) {
+        Node* const node = find_node(*this, key);
+
+        if (node == nullptr)
+            throw std::out_of_range("key not found");
+
+        return node->value;
     }
 
     bool insert(K key, T value) {
-        Stack<Node**> path;
+        Path path;
+        Node* cur = m_root;
 
-        Node** cur = &m_root;
+        while (cur != nullptr) {
+            const int order = three_way(cmp, key, cur->key);
+
+            if (order == 0) {
+                cur->value = std::move(value);
 
-        while (*cur != nullptr) {
-            path.push(cur);
+                // Aggregates over values must be refreshed up to the root.
+                if constexpr (AUGMENTED) {
+                    update(cur);
+
+                    while (!path.is_empty())
+                        update(path.pop().first);
+                }
 
-            if ((*cur)->key == key) {
-                (*cur)->value = std::move(value);
                 return false;
             }
 
-            if (cmp(key, (*cur)->key))
-                cur = &(*cur)->left;
-            else
-                cur = &(*cur)->right;
+            const Dir dir = order < 0 ? 0 : 1;
+            path.push({cur, dir});
+            cur = child(cur, dir);
         }
 
-        *cur = new Node(std::move(key), std::move(value), 0);
+        Node* const node = new Node(std::move(key), std::move(value));
+        update(node);
+        link(path, node);
         ++m_size;
 
+        // Balance factors are settled once a subtree stops growing, but augmented data still
+        // changes above it.
+        bool grew = true;
+
         while (!path.is_empty()) {
-            Node** const node = path.pop();
-            update_height(*node);
+            auto [x, dir] = path.pop();
+
+            if (grew) {
+                const int sign = dir == 0 ? -1 : 1;
+                const int x_balance = balance(x);
+
+                if (x_balance == 0) {
+                    set_balance(x, sign);
+                } else if (x_balance == -sign) {
+                    set_balance(x, 0);
+                    grew = false;
+                } else {
+                    rebalance(x, dir);
+                    link(path, x);
+                    grew = false;
+                }
+            }
 
-            if (std::abs(bf(*node)) > 1) {
-                rebalance(*node);
-                break;
+            update(x);
+
+            if constexpr (!AUGMENTED) {
+                if (!grew)
+                    break;
             }
         }
 
@@ -219,73 +594,252 @@ public:
     }
 
     bool remove(const K& key) {
-        Stack<Node**> path;
-        Node** cur = &m_root;
+        Path path;
+        Node* cur = m_root;
 
-        while (*cur != nullptr && (*cur)->key != key) {
-            path.push(cur);
+        while (cur != nullptr) {
+            const int order = three_way(cmp, key, cur->key);
+            if (order == 0)
+                break;
 
-            if (cmp(key, (*cur)->key))
-                cur = &(*cur)->left;
-            else
-                cur = &(*cur)->right;
+            const Dir dir = order < 0 ? 0 : 1;
+            path.push({cur, dir});
+            cur = child(cur, dir);
         }
 
-        if (*cur == nullptr)
+        if (cur == nullptr)
             return false;
 
-        if ((*cur)->left == nullptr && (*cur)->right == nullptr) {
-            delete std::exchange(*cur, nullptr);
-        } else if ((*cur)->left == nullptr) {
-            delete std::exchange(*cur, (*cur)->right);
-        } else if ((*cur)->right == nullptr) {
-            delete std::exchange(*cur, (*cur)->left);
-        } else {
-            path.push(cur);
-            Node** succ = &(*cur)->right;
-
-            while ((*succ)->left != nullptr) {
-                path.push(succ);
-                succ = &(*succ)->left;
-            }
+        if (cur->left != nullptr && cur->right != nullptr) {
+            // Move the successor's entry here and unlink the successor instead.
+            Node* const found = cur;
+            path.push({found, 1});
+            cur = found->right.get();
 
-            (*cur)->key = std::move((*succ)->key);
-            (*cur)->value = std::move((*succ)->value);
+            while (cur->left != nullptr) {
+                path.push({cur, 0});
+                cur = cur->left;
+            }
 
-            delete std::exchange(*succ, (*succ)->right);
+            found->key = std::move(cur->key);
+            found->value = std::move(cur->value);
         }
 
+        link(path, cur->left != nullptr ? cur->left : cur->right.get());
+        delete cur;
+        --m_size;
+
+        bool shrank = true;
+
         while (!path.is_empty()) {
-            Node** const node = path.pop();
-            update_height(*node);
+            auto [x, dir] = path.pop();
+
+            if (shrank) {
+                const int sign = dir == 0 ? -1 : 1;
+                const int x_balance = balance(x);
+
+                if (x_balance == sign) {
+                    set_balance(x, 0);
+                } else if (x_balance == 0) {
+                    set_balance(x, -sign);
+                    shrank = false;
+                } else {
+                    shrank = rebalance(x, !dir);
+                    link(path, x);
+                }
+            }
 
-            if (std::abs(bf(*node)) > 1)
-                rebalance(*node);
+            update(x);
+
+            if constexpr (!AUGMENTED) {
+                if (!shrank)
+                    break;
+            }
         }
 
-        --m_size;
         return true;
     }
 
-    [[nodiscard]] bool contains(const K& key) const {
-        Node* cur = m_root;
+    // Data of the whole tree, or null if it is empty.
+    [[nodiscard]] const Data* summary() const {
+        return m_root;
+    }
 
-        while (cur != nullptr) {
-            if (cur->key == key)
-                return true;
+    // Number of keys less than `key`.
+    [[nodiscard]] std::size_t rank(const K& key) const {
+        static_assert(augment_detail::has_size<Data>::value, "rank() requires SubtreeSize");
+        return augment_detail::count_less(m_root, key, false, cmp);
+    }
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
-        }
+    // Entry with the given 0-based position in key order.
+    [[nodiscard]] std::pair<const K&, const T&> select(const std::size_t index) const {
+        static_assert(augment_detail::has_size<Data>::value, "select() requires SubtreeSize");
+        const Node* const node = augment_detail::select<Node>(m_root, index);
+        return {node->key, node->value};
+    }
+
+    // Number of keys in [lo, hi].
+    [[nodiscard]] std::size_t count_range(const K& lo, const K& hi) const {
+        static_assert(augment_detail::has_size<Data>::value, "count_range() requires SubtreeSize");
 
-        return false;
+        if (cmp(hi, lo))
+            return 0;
+
+        return augment_detail::count_less(m_root, hi, true, cmp) -
+               augment_detail::count_less(m_root, lo, false, cmp);
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return find_node(*this, key) != nullptr;
     }
 
     void clear() {
         AvlTree().swap(*this);
     }
+
+    // Moves every entry whose key is not less than `key` into a new tree, which is returned.
+    // Takes O(log n) time with SubtreeSize; otherwise counting the moved entries makes it linear
+    // in their number.
+    AvlTree split(const K& key) {
+        Subtree left;
+        Subtree right;
+        Node* const found = Join::split(cmp, whole(), key, left, right);
+
+        if (found != nullptr)
+            right = join(Subtree(), found, right);
+
+        std::size_t moved = 0;
+
+        if constexpr (augment_detail::has_size<Data>::value)
+            moved = augment_detail::size(right.root);
+        else
+            moved = Join::count(right.root);
+
+        AvlTree result;
+        result.assign(right, moved);
+        assign(left, m_size - moved);
+
+        return result;
+    }
+
+    // Concatenates two trees in O(log n) time. Every key in `left` must be less than every key
+    // in `right`.
+    static AvlTree join(AvlTree left, AvlTree right) {
+        if (!left.is_empty() && !right.is_empty()) {
+            const Node* last = left.m_root;
+            while (last->right != nullptr)
+                last = last->right;
+
+            const Node* first = right.m_root;
+            while (first->left != nullptr)
+                first = first->left;
+
+            if (!left.cmp(last->key, first->key))
+                throw std::invalid_argument("Joined trees overlap");
+        }
+
+        AvlTree result;
+        result.assign(Join::join2(left.whole(), right.whole()), left.m_size + right.m_size);
+
+        left.assign(Subtree(), 0);
+        right.assign(Subtree(), 0);
+
+        return result;
+    }
+
+    // Adds every entry of `other`. Where both trees hold a key, the value from `other` wins, as
+    // with insert().
+    void union_with(AvlTree other, const Execution execution = Execution::Sequential) {
+        const std::size_t total = m_size + other.m_size;
+        const unsigned levels = join_detail::parallel_levels(execution, total);
+
+        std::size_t dropped = 0;
+        const Subtree result = Join::unite(cmp, whole(), other.whole(), dropped, levels);
+
+        other.assign(Subtree(), 0);
+        assign(result, total - dropped);
+    }
+
+    // Keeps only the entries whose keys are also in `other`.
+    void intersect_with(AvlTree other, const Execution execution = Execution::Sequential) {
+        const unsigned levels = join_detail::parallel_levels(execution, m_size + other.m_size);
+
+        std::size_t kept = 0;
+        const Subtree result = Join::intersect(cmp, whole(), other.whole(), kept, levels);
+
+        other.assign(Subtree(), 0);
+        assign(result, kept);
+    }
+
+    // Removes every entry whose key is in `other`.
+    void difference_with(AvlTree other, const Execution execution = Execution::Sequential) {
+        const unsigned levels = join_detail::parallel_levels(execution, m_size + other.m_size);
+
+        std::size_t removed = 0;
+        const Subtree result = Join::subtract(cmp, whole(), other.whole(), removed, levels);
+
+        other.assign(Subtree(), 0);
+        assign(result, m_size - removed);
+    }
+
+    [[nodiscard]] iterator begin() {
+        return iterator(m_root);
+    }
+
+    [[nodiscard]] iterator end() {
+        return iterator();
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(m_root);
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator();
+    }
+
+    // Stores the entries in key order.
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        Vec<const Node*> stack;
+        const Node* cur = m_root;
+
+        while (cur != nullptr || !stack.is_empty()) {
+            while (cur != nullptr) {
+                stack.push(cur);
+                cur = cur->left;
+            }
+
+            cur = stack.pop();
+            writer.write(cur->key);
+            writer.write(cur->value);
+            cur = cur->right;
+        }
+    }
+
+    // Entries arrive sorted, so the tree is rebuilt balanced in linear time instead of being
+    // re-inserted. Keys out of order mean a corrupt snapshot.
+    static AvlTree deserialize(BinaryReader& reader) {
+        const std::size_t count = reader.read_count<std::pair<K, T>>();
+        auto entries = Vec<std::pair<K, T>>::with_capacity(count);
+        const Compare cmp{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+            K key = reader.read<K>();
+
+            if (i > 0 && !cmp(entries[i - 1].first, key))
+                throw std::runtime_error("Snapshot keys are out of order");
+
+            entries.push({std::move(key), reader.read<T>()});
+        }
+
+        AvlTree tree;
+        std::ptrdiff_t height = 0;
+        tree.m_root = build(entries, 0, count, height);
+        tree.m_size = count;
+        return tree;
+    }
 };
 
 #endif
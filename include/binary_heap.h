@@ -4,8 +4,11 @@
 #include <cstddef>
 #include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include "binary_io.h"
 #include "vec.h"
 
 template<typename T, typename Compare = std::less<>>
@@ -59,6 +62,32 @@ class BinaryHeap {
         }
     }
 
+    void append_from(const std::size_t prev_size) {
+        if (should_rebuild(prev_size, data.size() - prev_size)) {
+            heapify();
+            return;
+        }
+
+        for (std::size_t i = prev_size; i < data.size(); ++i)
+            bubble_up(i);
+    }
+
+    void heapify() {
+        for (std::size_t i = 0; i < data.size() / 2; ++i)
+            bubble_down((data.size() / 2) - 1 - i);
+    }
+
+    // Whether rebuilding the whole heap in O(n + k) beats k bubble-ups of O(log n) each.
+    [[nodiscard]] static constexpr bool should_rebuild(const std::size_t prev_size,
+                                                      const std::size_t added) {
+        std::size_t log_size = 0;
+
+        for (std::size_t n = prev_size; n > 1; n /= 2)
+            ++log_size;
+
+        return 2 * (prev_size + added) < added * log_size;
+    }
+
 public:
     using iterator = typename Vec<T>::iterator;
     using const_iterator = typename Vec<T>::const_iterator;
@@ -69,8 +98,25 @@ public:
 
     BinaryHeap(std::initializer_list<T> elements)
         : data(elements) {
-        for (std::size_t i = 0; i < data.size() / 2; ++i)
-            bubble_down((data.size() / 2) - 1 - i);
+        heapify();
+    }
+
+    explicit BinaryHeap(Vec<T>&& elements)
+        : data(std::move(elements)) {
+        heapify();
+    }
+
+    template<typename InputIt>
+    BinaryHeap(InputIt first, InputIt last) {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>)
+            data.reserve(std::distance(first, last));
+
+        for (; first != last; ++first)
+            data.push(*first);
+
+        heapify();
     }
 
     [[nodiscard]] constexpr std::size_t size() const {
@@ -86,6 +132,33 @@ public:
         bubble_up(data.size() - 1);
     }
 
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last) {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>)
+            data.reserve(data.size() + std::distance(first, last));
+
+        const std::size_t prev_size = data.size();
+
+        for (; first != last; ++first)
+            data.push(*first);
+
+        append_from(prev_size);
+    }
+
+    void push_bulk(Vec<T>&& elements) {
+        data.reserve(data.size() + elements.size());
+
+        const std::size_t prev_size = data.size();
+
+        for (T& el : elements)
+            data.push(std::move(el));
+
+        elements.clear();
+        append_from(prev_size);
+    }
+
     T pop() {
         if (data.is_empty())
             throw std::out_of_range("Heap is empty");
@@ -97,6 +170,17 @@ public:
         return value;
     }
 
+    // Pops the top and pushes `value` with a single sift, O(log n).
+    T replace_top(T value) {
+        if (data.is_empty())
+            throw std::out_of_range("Heap is empty");
+
+        T top = std::exchange(data.first(), std::move(value));
+        bubble_down(0);
+
+        return top;
+    }
+
     T& peek() {
         if (data.is_empty())
             throw std::out_of_range("Heap is empty");
@@ -115,6 +199,17 @@ public:
         data.clear();
     }
 
+    // Stores the heap array as is, so loading it needs no heapify.
+    void serialize(BinaryWriter& writer) const {
+        data.serialize(writer);
+    }
+
+    static BinaryHeap deserialize(BinaryReader& reader) {
+        BinaryHeap heap;
+        heap.data = Vec<T>::deserialize(reader);
+        return heap;
+    }
+
     [[nodiscard]] constexpr iterator begin() {
         return data.begin();
     }
@@ -0,0 +1,162 @@
+#ifndef STRUCTZ_BINARY_IO_H
+#define STRUCTZ_BINARY_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace binary_io_detail {
+    template<typename T>
+    struct is_pair : std::false_type {};
+
+    template<typename A, typename B>
+    struct is_pair<std::pair<A, B>> : std::true_type {};
+
+    // The fewest bytes BinaryWriter::write() can produce for a T. Containers write at least
+    // their size.
+    template<typename T>
+    constexpr std::size_t min_encoded_size() {
+        if constexpr (std::is_empty_v<T>) {
+            return 0;
+        } else if constexpr (is_pair<T>::value) {
+            return min_encoded_size<typename T::first_type>() +
+                   min_encoded_size<typename T::second_type>();
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return sizeof(std::uint64_t);
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            return sizeof(T);
+        } else {
+            return sizeof(std::uint64_t);
+        }
+    }
+}
+
+// Streaming writer for the containers' binary snapshots. Values are encoded in native byte order:
+// empty types as nothing, std::pair and std::string field by field, other trivially copyable types
+// as their raw bytes, and everything else through its serialize(BinaryWriter&) member.
+class BinaryWriter {
+    std::ostream& m_out;
+    std::uint64_t m_position = 0;
+
+public:
+    explicit BinaryWriter(std::ostream& out);
+
+    // Bytes written so far.
+    [[nodiscard]] std::uint64_t position() const;
+
+    void write_bytes(const void* data, std::size_t size);
+
+    void write_size(std::size_t size);
+
+    // Pads with zeros up to the next multiple of `alignment`.
+    void align(std::size_t alignment);
+
+    // Magic number, format version and byte-order mark that open a snapshot file.
+    void write_header();
+
+    template<typename T>
+    void write(const T& value) {
+        if constexpr (std::is_empty_v<T>) {
+            return;
+        } else if constexpr (binary_io_detail::is_pair<T>::value) {
+            write(value.first);
+            write(value.second);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            write_size(value.size());
+            write_bytes(value.data(), value.size());
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            write_bytes(&value, sizeof(T));
+        } else {
+            value.serialize(*this);
+        }
+    }
+
+    // Trivially copyable arrays are aligned and written as one block, so that a mapping of the
+    // file can be used in place.
+    template<typename T>
+    void write_array(const T* const data, const std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T> && !std::is_empty_v<T>) {
+            align(alignof(T));
+            write_bytes(data, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i)
+                write(data[i]);
+        }
+    }
+};
+
+// Counterpart of BinaryWriter. Throws std::runtime_error on truncated or foreign input.
+class BinaryReader {
+    std::istream& m_in;
+    std::uint64_t m_position = 0;
+    // Bytes the stream held when the reader was made, or the maximum if it cannot seek.
+    std::uint64_t m_available;
+
+public:
+    static constexpr std::size_t HEADER_SIZE = 16;
+
+    explicit BinaryReader(std::istream& in);
+
+    // Validates a snapshot header found at the start of an in-memory buffer.
+    static void check_header(const std::byte* data, std::size_t size);
+
+    // Bytes read so far.
+    [[nodiscard]] std::uint64_t position() const;
+
+    void read_bytes(void* data, std::size_t size);
+
+    [[nodiscard]] std::size_t read_size();
+
+    // Reads the number of T that follow, and throws if the rest of the stream is too short to
+    // hold that many. Loaders allocate from the count, so a corrupt one must not get that far.
+    template<typename T>
+    [[nodiscard]] std::size_t read_count() {
+        const std::size_t count = read_size();
+        constexpr std::size_t min_size = binary_io_detail::min_encoded_size<T>();
+
+        if (min_size != 0 && count > (m_available - m_position) / min_size)
+            throw std::runtime_error("Snapshot count exceeds the data left");
+
+        return count;
+    }
+
+    void align(std::size_t alignment);
+
+    void read_header();
+
+    template<typename T>
+    [[nodiscard]] T read() {
+        if constexpr (std::is_empty_v<T>) {
+            return T{};
+        } else if constexpr (binary_io_detail::is_pair<T>::value) {
+            return T{read<typename T::first_type>(), read<typename T::second_type>()};
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            std::string value(read_count<char>(), '\0');
+            read_bytes(value.data(), value.size());
+            return value;
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            T value;
+            read_bytes(&value, sizeof(T));
+            return value;
+        } else {
+            return T::deserialize(*this);
+        }
+    }
+
+    template<typename T>
+    void read_array(T* const data, const std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T> && !std::is_empty_v<T>) {
+            align(alignof(T));
+            read_bytes(data, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i)
+                data[i] = read<T>();
+        }
+    }
+};
+
+#endif
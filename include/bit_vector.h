@@ -0,0 +1,52 @@
+#ifndef STRUCTZ_BIT_VECTOR_H
+#define STRUCTZ_BIT_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "vec.h"
+
+// Append-only bit vector with constant-time rank and logarithmic select. Call build_index() after
+// the last push() and before querying (pushing drops the index). The index costs 64 bits per 512
+// bits of data.
+class BitVector {
+    static constexpr std::size_t WORD_BITS = 64;
+    static constexpr std::size_t BLOCK_WORDS = 8;
+    static constexpr std::size_t BLOCK_BITS = WORD_BITS * BLOCK_WORDS;
+
+    Vec<std::uint64_t> m_words;
+    Vec<std::uint64_t> m_block_ranks;  // Ones before each block, plus the total at the end.
+    std::size_t m_size = 0;
+
+    [[nodiscard]] static std::size_t popcount(std::uint64_t word);
+
+    [[nodiscard]] static std::size_t select_in_word(std::uint64_t word, std::size_t k);
+
+    [[nodiscard]] std::size_t zeros_before_block(std::size_t block) const;
+
+    void check_index() const;
+
+public:
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] bool is_empty() const;
+
+    void push(bool bit);
+
+    void build_index();
+
+    [[nodiscard]] bool operator[](std::size_t index) const;
+
+    // Number of ones in [0, pos).
+    [[nodiscard]] std::size_t rank1(std::size_t pos) const;
+
+    // Number of zeros in [0, pos).
+    [[nodiscard]] std::size_t rank0(std::size_t pos) const;
+
+    // Position of the k-th one (0-based k).
+    [[nodiscard]] std::size_t select1(std::size_t k) const;
+
+    // Position of the k-th zero (0-based k).
+    [[nodiscard]] std::size_t select0(std::size_t k) const;
+};
+
+#endif
@@ -2,12 +2,32 @@
 #define STRUCTZ_BS_TREE_H
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <functional>
+#include <stdexcept>
 #include <utility>
+#include "binary_io.h"
+#include "compare.h"
 #include "stack.h"
+#include "vec.h"
+
+// How a BSTree keeps its depth in check.
+enum class Rebalancing : unsigned char {
+    // None at all: sorted insertions build a chain.
+    None,
+    // Scapegoat tree (Galperin and Rivest): when an insertion lands deeper than log_{3/2}(n), the
+    // lowest ancestor whose subtree is more than 2/3 inside one child is rebuilt perfectly
+    // balanced, and the whole tree is rebuilt once removals shrink it below 2/3 of its peak size.
+    // Depth stays O(log n) and updates take O(log n) amortized time, with nodes no larger than in
+    // the unbalanced tree.
+    Scapegoat,
+};
 
-template<typename K, typename T, typename Compare = std::less<K>>
+template<typename K,
+         typename T,
+         typename Compare = std::less<K>,
+         Rebalancing Mode = Rebalancing::None>
 class BSTree {
     struct Node {
         K key;
@@ -22,18 +42,124 @@ class BSTree {
 
     Node* m_root = nullptr;
     std::size_t m_size = 0;
+    // Largest size since the tree was last rebuilt as a whole; only tracked by scapegoat trees.
+    std::size_t m_max_size = 0;
     Compare cmp{};
 
-    static std::ptrdiff_t height(Node* const node) {
-        if (node == nullptr)
-            return -1;
+    [[nodiscard]] static std::size_t subtree_size(const Node* const root) {
+        std::size_t result = 0;
+        Vec<const Node*> stack;
+        stack.push(root);
+
+        while (!stack.is_empty()) {
+            const Node* const node = stack.pop();
+            if (node == nullptr)
+                continue;
+
+            ++result;
+            stack.push(node->left);
+            stack.push(node->right);
+        }
+
+        return result;
+    }
+
+    // Deepest a node may sit in a scapegoat tree of `size` entries: floor(log_{3/2}(size)).
+    [[nodiscard]] static std::size_t depth_limit(const std::size_t size) {
+        return static_cast<std::size_t>(std::log(static_cast<double>(size)) / std::log(1.5));
+    }
+
+    // Links nodes[first, last), which are in key order, into a balanced subtree.
+    static Node* link(const Vec<Node*>& nodes, const std::size_t first, const std::size_t last) {
+        if (first == last)
+            return nullptr;
+
+        const std::size_t mid = first + (last - first) / 2;
+        Node* const node = nodes[mid];
 
-        return 1 + std::max(height(node->left), height(node->right));
+        node->left = link(nodes, first, mid);
+        node->right = link(nodes, mid + 1, last);
+
+        return node;
+    }
+
+    // Rebalances the subtree hanging from `slot`, which holds `size` nodes, reusing its nodes.
+    static void rebuild(Node*& slot, const std::size_t size) {
+        auto nodes = Vec<Node*>::with_capacity(size);
+        Vec<Node*> stack;
+        Node* cur = slot;
+
+        while (cur != nullptr || !stack.is_empty()) {
+            while (cur != nullptr) {
+                stack.push(cur);
+                cur = cur->left;
+            }
+
+            cur = stack.pop();
+            nodes.push(cur);
+            cur = cur->right;
+        }
+
+        slot = link(nodes, 0, nodes.size());
+    }
+
+    // Called after inserting a node `depth` levels below the root. If it went too deep, finds the
+    // scapegoat among its ancestors and rebuilds it.
+    void rebalance_after_insert(const K& key, const std::size_t depth) {
+        if (depth <= depth_limit(m_size))
+            return;
+
+        // The insertion itself stayed cheap, so the path is only recorded when it is needed.
+        auto path = Vec<Node**>::with_capacity(depth + 1);
+        Node** cur = &m_root;
+
+        while (*cur != nullptr) {
+            path.push(cur);
+
+            const int order = three_way(cmp, key, (*cur)->key);
+            if (order == 0)
+                break;
+
+            cur = order < 0 ? &(*cur)->left : &(*cur)->right;
+        }
+
+        std::size_t child_size = 1;
+
+        for (std::size_t i = path.size() - 1; i-- > 0;) {
+            const Node* const node = *path[i];
+            const Node* const child = *path[i + 1];
+            const Node* const sibling = node->left == child ? node->right : node->left;
+            const std::size_t size = child_size + 1 + subtree_size(sibling);
+
+            if (3 * child_size > 2 * size) {
+                rebuild(*path[i], size);
+                return;
+            }
+
+            child_size = size;
+        }
+    }
+
+    // Builds a balanced tree out of entries[first, last), which must be sorted by key.
+    static Node* build(Vec<std::pair<K, T>>& entries,
+                       const std::size_t first,
+                       const std::size_t last) {
+        if (first == last)
+            return nullptr;
+
+        const std::size_t mid = first + (last - first) / 2;
+        Node* const node = new Node(std::move(entries[mid].first), std::move(entries[mid].second));
+
+        node->left = build(entries, first, mid);
+        node->right = build(entries, mid + 1, last);
+
+        return node;
     }
 
     void swap(BSTree& other) noexcept {
         std::swap(m_root, other.m_root);
         std::swap(m_size, other.m_size);
+        std::swap(m_max_size, other.m_max_size);
     }
 
 public:
@@ -166,6 +292,7 @@ public:
         }
 
         m_size = other.m_size;
+        m_max_size = other.m_max_size;
     }
 
     BSTree(BSTree&& other) noexcept {
@@ -207,21 +334,62 @@ public:
         return m_size == 0;
     }
 
+    // Walks the whole tree without recursion, so degenerate trees of any depth are fine.
     [[nodiscard]] std::ptrdiff_t height() const {
-        return height(m_root);
+        std::ptrdiff_t result = -1;
+        Vec<std::pair<const Node*, std::ptrdiff_t>> stack;
+        stack.push({m_root, 0});
+
+        while (!stack.is_empty()) {
+            const auto [node, depth] = stack.pop();
+            if (node == nullptr)
+                continue;
+
+            result = std::max(result, depth);
+            stack.push({node->left, depth + 1});
+            stack.push({node->right, depth + 1});
+        }
+
+        return result;
+    }
+
+    // Checks that the keys are in order and that size() matches the number of nodes, in one
+    // iterative O(n) pass.
+    [[nodiscard]] bool check_properties() const {
+        std::size_t count = 0;
+        const Node* previous = nullptr;
+        Vec<const Node*> stack;
+        const Node* cur = m_root;
+
+        while (cur != nullptr || !stack.is_empty()) {
+            while (cur != nullptr) {
+                stack.push(cur);
+                cur = cur->left;
+            }
+
+            const Node* const node = stack.pop();
+
+            if (previous != nullptr && !cmp(previous->key, node->key))
+                return false;
+
+            previous = node;
+            ++count;
+            cur = node->right;
+        }
+
+        return count == m_size;
     }
 
     [[nodiscard]] bool contains(const K& key) const {
         Node* cur = m_root;
 
         while (cur != nullptr) {
-            if (cur->key == key)
+            const int order = three_way(cmp, key, cur->key);
+
+            if (order == 0)
                 return true;
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
+            cur = order < 0 ? cur->left : cur->right;
         }
 
         return false;
@@ -231,13 +399,12 @@ public:
         Node* cur = m_root;
 
         while (cur != nullptr) {
-            if (cur->key == key)
+            const int order = three_way(cmp, key, cur->key);
+
+            if (order == 0)
                 return cur->value;
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
+            cur = order < 0 ? cur->left : cur->right;
         }
 
         throw std::out_of_range("Key not found");
@@ -247,13 +414,12 @@ public:
         Node* cur = m_root;
 
         while (cur != nullptr) {
-            if (cur->key == key)
+            const int order = three_way(cmp, key, cur->key);
+
+            if (order == 0)
                 return cur->value;
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
+            cur = order < 0 ? cur->left : cur->right;
         }
 
         throw std::out_of_range("Key not found");
@@ -261,33 +427,40 @@ public:
 
     bool insert(K key, T value) {
         Node** cur = &m_root;
+        std::size_t depth = 0;
 
         while (*cur != nullptr) {
-            if ((*cur)->key == key) {
+            const int order = three_way(cmp, key, (*cur)->key);
+
+            if (order == 0) {
                 (*cur)->value = std::move(value);
                 return false;
             }
 
-            if (cmp(key, (*cur)->key))
-                cur = &(*cur)->left;
-            else
-                cur = &(*cur)->right;
+            cur = order < 0 ? &(*cur)->left : &(*cur)->right;
+            ++depth;
         }
 
         *cur = new Node(std::move(key), std::move(value));
         ++m_size;
 
+        if constexpr (Mode == Rebalancing::Scapegoat) {
+            m_max_size = std::max(m_max_size, m_size);
+            rebalance_after_insert((*cur)->key, depth);
+        }
+
         return true;
     }
 
     bool remove(const K& key) {
         Node** cur = &m_root;
 
-        while (*cur != nullptr && (*cur)->key != key) {
-            if (cmp(key, (*cur)->key))
-                cur = &(*cur)->left;
-            else
-                cur = &(*cur)->right;
+        while (*cur != nullptr) {
+            const int order = three_way(cmp, key, (*cur)->key);
+            if (order == 0)
+                break;
+
+            cur = order < 0 ? &(*cur)->left : &(*cur)->right;
         }
 
         if (*cur == nullptr)
@@ -310,6 +483,14 @@ public:
         }
 
         --m_size;
+
+        if constexpr (Mode == Rebalancing::Scapegoat) {
+            if (3 * m_size < 2 * m_max_size) {
+                rebuild(m_root, m_size);
+                m_max_size = m_size;
+            }
+        }
+
         return true;
     }
 
@@ -317,6 +498,49 @@ public:
         BSTree().swap(*this);
     }
 
+    // Stores the entries in key order.
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        Stack<const Node*> stack;
+        const Node* cur = m_root;
+
+        while (cur != nullptr || !stack.is_empty()) {
+            while (cur != nullptr) {
+                stack.push(cur);
+                cur = cur->left;
+            }
+
+            cur = stack.pop();
+            writer.write(cur->key);
+            writer.write(cur->value);
+            cur = cur->right;
+        }
+    }
+
+    // Entries arrive sorted, so the tree is rebuilt balanced in linear time instead of being
+    // re-inserted. Keys out of order mean a corrupt snapshot.
+    static BSTree deserialize(BinaryReader& reader) {
+        const std::size_t count = reader.read_count<std::pair<K, T>>();
+        auto entries = Vec<std::pair<K, T>>::with_capacity(count);
+        const Compare cmp{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+            K key = reader.read<K>();
+
+            if (i > 0 && !cmp(entries[i - 1].first, key))
+                throw std::runtime_error("Snapshot keys are out of order");
+
+            entries.push({std::move(key), reader.read<T>()});
+        }
+
+        BSTree tree;
+        tree.m_root = build(entries, 0, count);
+        tree.m_size = count;
+        tree.m_max_size = count;
+        return tree;
+    }
+
     [[nodiscard]] iterator begin() {
         return iterator(m_root);
     }
@@ -13,6 +13,8 @@
 #include <string>
 #include <utility>
 #include <variant>
+#include "binary_io.h"
+#include "compare.h"
 #include "stack.h"
 #include "vec.h"
 
@@ -40,17 +42,29 @@ class BTree {
     Node* m_root = nullptr;
     Compare cmp{};
 
+    // Index of the first entry in `node` whose key is not less than `key`, and whether it is
+    // equal to it.
+    static std::pair<std::size_t, bool> search(const Compare& cmp,
+                                               const Node* const node,
+                                               const K& key) {
+        for (std::size_t i = 0; i < node->size; ++i) {
+            const int order = three_way(cmp, node->entries[i].key, key);
+
+            if (order >= 0)
+                return {i, order == 0};
+        }
+
+        return {node->size, false};
+    }
+
     template<typename Self>
     static auto& get(Self& self, const K& key) {
         auto* cur = self.m_root;
 
         while (cur != nullptr) {
-            std::size_t i = 0;
+            const auto [i, found] = search(self.cmp, cur, key);
 
-            while (i < cur->size && self.cmp(cur->entries[i].key, key))
-                ++i;
-
-            if (i < cur->size && cur->entries[i].key == key)
+            if (found)
                 return cur->entries[i].value;
 
             if (cur->is_leaf)
@@ -111,12 +125,12 @@ class BTree {
         return result;
     }
 
-    template<typename Self>
-    void range_search(Self& self,
-                      Node* const node,
-                      Vec<std::pair<const K*, T*>>& out,
-                      const K& begin,
-                      const K& end) {
+    template<typename Self, typename Out>
+    static void range_search(Self& self,
+                             Node* const node,
+                             Out& out,
+                             const K& begin,
+                             const K& end) {
         if (node == nullptr)
             return;
 
@@ -133,6 +147,74 @@ class BTree {
         range_search(self, node->children[node->size], out, begin, end);
     }
 
+    static void serialize(const Node* const node, BinaryWriter& writer) {
+        if (node == nullptr)
+            return;
+
+        for (std::size_t i = 0; i < node->size; ++i) {
+            serialize(node->children[i], writer);
+            writer.write(node->entries[i].key);
+            writer.write(node->entries[i].value);
+        }
+
+        serialize(node->children[node->size], writer);
+    }
+
+    // Builds a subtree of the given height out of the next `count` sorted entries. Each child gets
+    // an even share of them, which keeps every node between the minimum and maximum fill.
+    static Node* build(Vec<Entry>& entries,
+                       std::size_t& next,
+                       const std::size_t count,
+                       const std::size_t height) {
+        Node* const node = new Node();
+        node->is_leaf = height == 0;
+
+        if (height == 0) {
+            for (std::size_t i = 0; i < count; ++i)
+                node->entries[i] = std::move(entries[next++]);
+
+            node->size = count;
+            return node;
+        }
+
+        // A child subtree holds at most span - 1 entries.
+        std::size_t span = 1;
+        for (std::size_t i = 0; i < height; ++i)
+            span *= M;
+
+        const std::size_t children = std::max<std::size_t>(2, (count + span) / span);
+
+        for (std::size_t i = 0; i < children; ++i) {
+            const std::size_t share = (count + 1) / children + (i < (count + 1) % children);
+            node->children[i] = build(entries, next, share - 1, height - 1);
+
+            if (i + 1 < children)
+                node->entries[i] = std::move(entries[next++]);
+        }
+
+        node->size = children - 1;
+        return node;
+    }
+
+    // Bulk-loads entries sorted by strictly increasing key.
+    static BTree build(Vec<Entry>& entries) {
+        BTree result;
+
+        if (entries.is_empty())
+            return result;
+
+        std::size_t height = 0;
+
+        for (std::size_t capacity = M; entries.size() + 1 > capacity; capacity *= M)
+            ++height;
+
+        std::size_t next = 0;
+        result.m_root = build(entries, next, entries.size(), height);
+        result.m_size = entries.size();
+
+        return result;
+    }
+
     void swap(BTree& other) noexcept {
         std::swap(m_root, other.m_root);
         std::swap(m_size, other.m_size);
@@ -142,11 +224,9 @@ class BTree {
         if (node == nullptr)
             return std::pair{Entry(std::move(key), std::move(value)), nullptr};
 
-        std::size_t i = 0;
-        while (i < node->size && cmp(node->entries[i].key, key))
-            ++i;
+        const auto [i, found] = search(cmp, node, key);
 
-        if (i < node->size && node->entries[i].key == key) {
+        if (found) {
             node->entries[i].value = std::move(value);
             return false;
         }
@@ -257,11 +337,7 @@ class BTree {
         if (node == nullptr)
             return DeleteResult::NotDeleted;
 
-        std::size_t i = 0;
-        while (i < node->size && cmp(node->entries[i].key, key))
-            ++i;
-
-        const bool found_key = i < node->size && node->entries[i].key == key;
+        const auto [i, found_key] = search(cmp, node, key);
 
         if (found_key && node->is_leaf) {
             // Found the key!
@@ -360,74 +436,29 @@ class BTree {
         return height;
     }
 
-    [[nodiscard]] bool check_properties(const Node* const node) const {
-        if (node == nullptr)
-            return true;
-
-        const std::size_t min_entries = node == m_root ? 1 : std::ceil(M / 2.0) - 1;
-        const std::size_t max_entries = M - 1;
-
-        // Check entry count
-        if (node->size < min_entries || node->size > max_entries)
-            return false;
-
-        // Keys must be ordered
-        for (std::size_t i = 0; i < node->size - 1; ++i) {
-            if (!cmp(node->entries[i].key, node->entries[i + 1].key))
-                return false;
-        }
-
-        if (!node->is_leaf) {
-            // Non-leaf nodes must have size + 1 children
-            for (std::size_t i = 0; i < node->size + 1; ++i) {
-                if (node->children[i] == nullptr)
-                    return false;
-            }
-
-            // Check properties recursively
-            for (std::size_t i = 0; i < node->size + 1; ++i) {
-                if (!check_properties(node->children[i]))
-                    return false;
-            }
-
-            const std::size_t expected_height = height(node->children[0]);
+public:
+    // Elements sorted by strictly increasing key are packed bottom-up in linear time. Any other
+    // input is inserted one element at a time, the last value winning for a repeated key.
+    static BTree build_from_ordered_vector(const Vec<std::pair<K, T>>& elements) {
+        const Compare cmp{};
 
-            // Subtree heights should be equal
-            for (std::size_t i = 1; i < node->size + 1; ++i) {
-                // NOTE: esta llamada es costosa. Podría aplicarse un caché o algo parecido, pero no
-                // estamos considerando mucho el costo de check_properties.
-                if (height(node->children[i]) != expected_height)
-                    return false;
-            }
+        for (std::size_t i = 1; i < elements.size(); ++i) {
+            if (!cmp(elements[i - 1].first, elements[i].first)) {
+                BTree result;
 
-            // Check that subtrees go inside the correct entries
-            for (std::size_t i = 0; i < node->size; ++i) {
-                const K& key = node->entries[i].key;
-                const K& min = max_key(node->children[i]);
-                const K& max = min_key(node->children[i + 1]);
+                for (const auto& el : elements)
+                    result.insert(el.first, el.second);
 
-                if (!cmp(min, key) || !cmp(key, max))
-                    return false;
-            }
-        } else {
-            // Leaf nodes should have no children
-            for (std::size_t i = 0; i < node->size + 1; ++i) {
-                if (node->children[i] != nullptr)
-                    return false;
+                return result;
             }
         }
 
-        return true;
-    }
-
-public:
-    static BTree build_from_ordered_vector(const Vec<std::pair<K, T>>& elements) {
-        BTree result;
+        auto entries = Vec<Entry>::with_capacity(elements.size());
 
         for (const auto& el : elements)
-            result.insert(el.first, el.second);
+            entries.push(Entry(el.first, el.second));
 
-        return result;
+        return build(entries);
     }
 
     BTree() = default;
@@ -500,20 +531,80 @@ public:
         return m_size == 0;
     }
 
+    // Checks entry counts, key order (within nodes and against the separators above them) and
+    // that all leaves are at the same depth, in a single iterative O(n) pass.
     [[nodiscard]] bool check_properties() const {
-        return check_properties(m_root);
+        if (m_root == nullptr)
+            return true;
+
+        // A node, its depth and the keys its entries must lie strictly between, if any.
+        struct Frame {
+            const Node* node;
+            std::ptrdiff_t depth;
+            const K* lower;
+            const K* upper;
+        };
+
+        Vec<Frame> stack;
+        stack.push({m_root, 0, nullptr, nullptr});
+
+        std::ptrdiff_t leaf_depth = -1;
+
+        while (!stack.is_empty()) {
+            const Frame frame = stack.pop();
+            const Node* const node = frame.node;
+            const std::size_t min_entries = node == m_root ? 1 : (M + 1) / 2 - 1;
+
+            if (node->size < min_entries || node->size > M - 1)
+                return false;
+
+            const K* previous = frame.lower;
+
+            for (std::size_t i = 0; i < node->size; ++i) {
+                if (previous != nullptr && !cmp(*previous, node->entries[i].key))
+                    return false;
+
+                previous = &node->entries[i].key;
+            }
+
+            if (frame.upper != nullptr && !cmp(*previous, *frame.upper))
+                return false;
+
+            if (node->is_leaf) {
+                for (std::size_t i = 0; i < node->size + 1; ++i) {
+                    if (node->children[i] != nullptr)
+                        return false;
+                }
+
+                if (leaf_depth == -1)
+                    leaf_depth = frame.depth;
+                else if (leaf_depth != frame.depth)
+                    return false;
+
+                continue;
+            }
+
+            for (std::size_t i = 0; i < node->size + 1; ++i) {
+                if (node->children[i] == nullptr)
+                    return false;
+
+                stack.push({node->children[i],
+                            frame.depth + 1,
+                            i == 0 ? frame.lower : &node->entries[i - 1].key,
+                            i == node->size ? frame.upper : &node->entries[i].key});
+            }
+        }
+
+        return true;
     }
 
     [[nodiscard]] bool contains_key(const K& key) const {
         const Node* cur = m_root;
 
         while (cur != nullptr) {
-            std::size_t i = 0;
+            const auto [i, found] = search(cmp, cur, key);
 
-            while (i < cur->size && cmp(cur->entries[i].key, key))
-                ++i;
-
-            if (i < cur->size && cur->entries[i].key == key)
+            if (found)
                 return true;
 
             if (cur->is_leaf)
@@ -609,6 +700,29 @@ public:
     void clear() {
         BTree().swap(*this);
     }
+
+    // Stores the entries in key order.
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+        serialize(m_root, writer);
+    }
+
+    static BTree deserialize(BinaryReader& reader) {
+        const std::size_t count = reader.read_count<std::pair<K, T>>();
+        auto entries = Vec<Entry>::with_capacity(count);
+        const Compare cmp{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+            K key = reader.read<K>();
+
+            if (i > 0 && !cmp(entries[i - 1].key, key))
+                throw std::runtime_error("Snapshot keys are out of order");
+
+            entries.push(Entry(std::move(key), reader.read<T>()));
+        }
+
+        return build(entries);
+    }
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <utility>
+#include "binary_io.h"
 
 template<typename T>
 class CircularList {
@@ -319,6 +320,22 @@ public:
         std::swap(head(), tail());
     }
 
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        for (const Node* cur = head(); cur != m_sentinel; cur = cur->next)
+            writer.write(cur->data);
+    }
+
+    static CircularList<T> deserialize(BinaryReader& reader) {
+        CircularList<T> list;
+
+        for (std::size_t i = reader.read_count<T>(); i > 0; --i)
+            list.push_back(reader.read<T>());
+
+        return list;
+    }
+
     [[nodiscard]] constexpr iterator begin() {
         return iterator(head());
     }
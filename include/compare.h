@@ -0,0 +1,59 @@
+#ifndef STRUCTZ_COMPARE_H
+#define STRUCTZ_COMPARE_H
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Three-way comparison for the search trees, so that visiting a node costs a single comparison
+// instead of an equality test followed by a less-than.
+//
+// three_way(cmp, a, b) is negative if a < b, zero if they are equivalent and positive otherwise.
+// It uses, in order of preference:
+//
+//   - `cmp.compare(a, b)`, for comparators that provide one;
+//   - `a.compare(b)` when `cmp` is std::less and the key has such a member (std::string,
+//     std::string_view...);
+//   - `cmp(a, b)` and then `cmp(b, a)` if the first one is false.
+namespace compare_detail {
+    template<typename Compare, typename K, typename = void>
+    struct has_compare : std::false_type {};
+
+    template<typename Compare, typename K>
+    struct has_compare<Compare,
+                       K,
+                       std::void_t<decltype(std::declval<const Compare&>().compare(
+                           std::declval<const K&>(), std::declval<const K&>()))>>
+        : std::true_type {};
+
+    template<typename K, typename = void>
+    struct has_member_compare : std::false_type {};
+
+    template<typename K>
+    struct has_member_compare<
+        K,
+        std::enable_if_t<std::is_convertible_v<decltype(std::declval<const K&>().compare(
+                                                   std::declval<const K&>())),
+                                               int>>> : std::true_type {};
+
+    template<typename Compare, typename K>
+    constexpr bool is_less_v =
+        std::is_same_v<Compare, std::less<K>> || std::is_same_v<Compare, std::less<>>;
+}
+
+template<typename Compare, typename K>
+[[nodiscard]] int three_way(const Compare& cmp, const K& a, const K& b) {
+    if constexpr (compare_detail::has_compare<Compare, K>::value) {
+        return cmp.compare(a, b);
+    } else if constexpr (compare_detail::is_less_v<Compare, K> &&
+                         compare_detail::has_member_compare<K>::value) {
+        return a.compare(b);
+    } else {
+        if (cmp(a, b))
+            return -1;
+
+        return cmp(b, a) ? 1 : 0;
+    }
+}
+
+#endif
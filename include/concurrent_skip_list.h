@@ -0,0 +1,398 @@
+#ifndef STRUCTZ_CONCURRENT_SKIP_LIST_H
+#define STRUCTZ_CONCURRENT_SKIP_LIST_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "epoch.h"
+#include "vec.h"
+
+// Lock-free ordered map for any number of concurrent readers and writers: a skip list in the
+// style of Fraser and of Herlihy and Shavit. Nodes are linked at level 0 with a single CAS,
+// which is what makes them part of the map; the upper levels are shortcuts added afterwards.
+// Removal marks the links leaving a node, top level first, and whoever marks level 0 owns the
+// removal. Searches unlink the marked nodes they meet, and the nodes are freed through an
+// EpochDomain once no operation can still be looking at them.
+//
+// Values are boxed, so that insert() can swap a new one in atomically, and read by copy: a
+// reference could outlive the value. Scans are weakly consistent, seeing every entry present
+// for the whole scan and maybe some of those added or removed meanwhile.
+template<typename K, typename T, typename Compare = std::less<K>>
+class ConcurrentSkipList {
+    // A node reaches level i + 1 with probability 4^-i; 16 levels serve billions of entries.
+    static constexpr std::size_t MAX_LEVEL = 16;
+
+    struct Node {
+        const K key;
+        std::atomic<T*> value;
+        const std::size_t level;
+        // Bumped by the inserter once it stops linking the node, and by the thread that removes
+        // it. Whichever comes second unlinks it for good and retires it, so no upper level can
+        // be linked after that.
+        std::atomic<unsigned char> handoff{0};
+
+        Node(K key, T* const value, const std::size_t level)
+            : key(std::move(key)),
+              value(value),
+              level(level) {}
+
+        ~Node() {
+            delete value.load(std::memory_order_relaxed);
+        }
+
+        // The links live right after the node, in the same allocation. The lowest bit of a link
+        // is set once this node is being removed.
+        [[nodiscard]] std::atomic<Node*>* next() {
+            return reinterpret_cast<std::atomic<Node*>*>(this + 1);
+        }
+    };
+
+    using Links = std::array<Node*, MAX_LEVEL>;
+
+    std::array<std::atomic<Node*>, MAX_LEVEL> m_head;
+    std::atomic<std::size_t> m_size{0};
+    // Pinned by readers too, hence mutable.
+    mutable EpochDomain m_epoch;
+    Compare cmp{};
+
+    [[nodiscard]] static bool is_marked(Node* const link) {
+        return (reinterpret_cast<std::uintptr_t>(link) & 1) != 0;
+    }
+
+    [[nodiscard]] static Node* marked(Node* const link) {
+        return reinterpret_cast<Node*>(reinterpret_cast<std::uintptr_t>(link) | 1);
+    }
+
+    [[nodiscard]] static Node* unmarked(Node* const link) {
+        const auto bits = reinterpret_cast<std::uintptr_t>(link);
+        return reinterpret_cast<Node*>(bits & ~std::uintptr_t{1});
+    }
+
+    static Node* create(K key, T* const value, const std::size_t level) {
+        static_assert(alignof(Node) >= alignof(std::atomic<Node*>));
+
+        void* const memory = ::operator new(sizeof(Node) + level * sizeof(std::atomic<Node*>));
+        Node* node = nullptr;
+
+        try {
+            node = new (memory) Node(std::move(key), value, level);
+        } catch (...) {
+            ::operator delete(memory);
+            throw;
+        }
+
+        for (std::size_t i = 0; i < level; ++i)
+            new (node->next() + i) std::atomic<Node*>(nullptr);
+
+        return node;
+    }
+
+    static void destroy(Node* const node) {
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    static void destroy_erased(void* const node) {
+        destroy(static_cast<Node*>(node));
+    }
+
+    // The links leaving `node`, or the head's for null.
+    [[nodiscard]] std::atomic<Node*>* links(Node* const node) const {
+        return node == nullptr ? const_cast<std::atomic<Node*>*>(m_head.data()) : node->next();
+    }
+
+    [[nodiscard]] static std::size_t random_level() {
+        static thread_local std::uint64_t seed =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+
+        // xorshift64
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        std::uint64_t bits = seed;
+        std::size_t level = 1;
+
+        while (level < MAX_LEVEL && (bits & 3) == 0) {
+            ++level;
+            bits >>= 2;
+        }
+
+        return level;
+    }
+
+    // One attempt at find(). Gives up, returning false, when it meets a link of a node that is
+    // being removed: that link may lead to freed memory, so the search has to start over.
+    bool try_find(const K& key, Links& preds, Links& succs) const {
+        Node* pred = nullptr;
+
+        for (std::size_t i = MAX_LEVEL; i-- > 0;) {
+            Node* cur = links(pred)[i].load(std::memory_order_acquire);
+
+            while (true) {
+                if (is_marked(cur))
+                    return false;
+
+                if (cur == nullptr)
+                    break;
+
+                Node* const next = cur->next()[i].load(std::memory_order_acquire);
+
+                // `cur` is being removed, and still linked after `pred`, so its successor is
+                // safe to link there instead.
+                if (is_marked(next)) {
+                    if (!links(pred)[i].compare_exchange_strong(cur,
+                                                                unmarked(next),
+                                                                std::memory_order_acq_rel,
+                                                                std::memory_order_acquire))
+                        return false;
+
+                    cur = unmarked(next);
+                    continue;
+                }
+
+                if (!cmp(cur->key, key))
+                    break;
+
+                pred = cur;
+                cur = next;
+            }
+
+            preds[i] = pred;
+            succs[i] = cur;
+        }
+
+        return true;
+    }
+
+    // Fills, on every level, `preds` with the last node whose key is less than `key` (null for
+    // the head) and `succs` with the node after it, unlinking the marked nodes met on the way.
+    // Returns whether succs[0] holds `key`. Readers search this way too, so that a stalled
+    // remover cannot hold them up. Must run pinned.
+    bool find(const K& key, Links& preds, Links& succs) const {
+        while (!try_find(key, preds, succs)) {
+        }
+
+        return succs[0] != nullptr && !cmp(key, succs[0]->key);
+    }
+
+    // Called by the second of the inserter and the remover of `node`.
+    void unlink_and_retire(EpochDomain::Guard& guard, Node* const node) {
+        Links preds;
+        Links succs;
+
+        // A search for the key goes past `node` on every level it is linked on, and unlinks it
+        // there since all its links are marked.
+        find(node->key, preds, succs);
+        guard.retire(node, destroy_erased);
+    }
+
+    void release(EpochDomain::Guard& guard, Node* const node) {
+        if (node->handoff.fetch_add(1, std::memory_order_acq_rel) == 1)
+            unlink_and_retire(guard, node);
+    }
+
+public:
+    ConcurrentSkipList() {
+        for (auto& link : m_head)
+            link.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    // Must not run concurrently with anything else. Nodes already retired are freed by the
+    // epoch domain.
+    ~ConcurrentSkipList() {
+        Node* node = m_head[0].load(std::memory_order_acquire);
+
+        while (node != nullptr) {
+            Node* const next = unmarked(node->next()[0].load(std::memory_order_acquire));
+            destroy(node);
+            node = next;
+        }
+    }
+
+    // Exact when no update is running.
+    [[nodiscard]] std::size_t size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool is_empty() const {
+        return size() == 0;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        const auto guard = m_epoch.pin();
+        Links preds;
+        Links succs;
+        return find(key, preds, succs);
+    }
+
+    [[nodiscard]] std::optional<T> find(const K& key) const {
+        const auto guard = m_epoch.pin();
+        Links preds;
+        Links succs;
+
+        if (!find(key, preds, succs))
+            return std::nullopt;
+
+        return *succs[0]->value.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] T get(const K& key) const {
+        std::optional<T> value = find(key);
+
+        if (!value)
+            throw std::out_of_range("Key not found");
+
+        return std::move(*value);
+    }
+
+    // Copies of the entries with keys in [begin, end], in order.
+    [[nodiscard]] Vec<std::pair<K, T>> range_search(const K& begin, const K& end) const {
+        const auto guard = m_epoch.pin();
+        Vec<std::pair<K, T>> out;
+        Links preds;
+        Links succs;
+
+        find(begin, preds, succs);
+        Node* node = succs[0];
+
+        while (node != nullptr && !cmp(end, node->key)) {
+            Node* const next = node->next()[0].load(std::memory_order_acquire);
+
+            if (!is_marked(next)) {
+                out.push({node->key, *node->value.load(std::memory_order_acquire)});
+                node = next;
+                continue;
+            }
+
+            // The node is being removed, so its link cannot be followed. A new search lands
+            // past it.
+            find(node->key, preds, succs);
+            node = succs[0];
+        }
+
+        return out;
+    }
+
+    // Inserts or overwrites `key`. Returns whether it was new.
+    bool insert(K key, T value) {
+        auto guard = m_epoch.pin();
+        T* const boxed = new T(std::move(value));
+        Node* node = nullptr;
+        Links preds;
+        Links succs;
+
+        while (true) {
+            const K& target = node == nullptr ? key : node->key;
+
+            if (find(target, preds, succs)) {
+                guard.retire(succs[0]->value.exchange(boxed, std::memory_order_acq_rel));
+
+                // Never published, so it can go right away, but the value is in use.
+                if (node != nullptr) {
+                    node->value.store(nullptr, std::memory_order_relaxed);
+                    destroy(node);
+                }
+
+                return false;
+            }
+
+            if (node == nullptr)
+                node = create(std::move(key), boxed, random_level());
+
+            node->next()[0].store(succs[0], std::memory_order_relaxed);
+
+            if (links(preds[0])[0].compare_exchange_strong(succs[0],
+                                                           node,
+                                                           std::memory_order_release,
+                                                           std::memory_order_relaxed))
+                break;
+        }
+
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        for (std::size_t i = 1; i < node->level; ++i) {
+            while (true) {
+                Node* expected = node->next()[i].load(std::memory_order_acquire);
+
+                // A remover has started marking the node: it is not worth linking any higher.
+                if (is_marked(expected) ||
+                    !node->next()[i].compare_exchange_strong(expected,
+                                                             succs[i],
+                                                             std::memory_order_acq_rel,
+                                                             std::memory_order_acquire)) {
+                    release(guard, node);
+                    return true;
+                }
+
+                if (links(preds[i])[i].compare_exchange_strong(succs[i],
+                                                               node,
+                                                               std::memory_order_release,
+                                                               std::memory_order_relaxed))
+                    break;
+
+                // The neighbourhood changed. If the node was removed meanwhile, the search
+                // lands past it.
+                if (!find(node->key, preds, succs) || succs[0] != node) {
+                    release(guard, node);
+                    return true;
+                }
+            }
+        }
+
+        release(guard, node);
+        return true;
+    }
+
+    bool remove(const K& key) {
+        auto guard = m_epoch.pin();
+        Links preds;
+        Links succs;
+
+        if (!find(key, preds, succs))
+            return false;
+
+        Node* const node = succs[0];
+
+        for (std::size_t i = node->level; i-- > 1;) {
+            Node* next = node->next()[i].load(std::memory_order_acquire);
+
+            while (!is_marked(next) &&
+                   !node->next()[i].compare_exchange_weak(next,
+                                                          marked(next),
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_acquire)) {
+            }
+        }
+
+        Node* next = node->next()[0].load(std::memory_order_acquire);
+
+        while (true) {
+            // Someone else removed it first.
+            if (is_marked(next))
+                return false;
+
+            if (node->next()[0].compare_exchange_weak(next,
+                                                      marked(next),
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire))
+                break;
+        }
+
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        release(guard, node);
+        return true;
+    }
+};
+
+#endif
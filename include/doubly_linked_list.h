@@ -5,6 +5,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <utility>
+#include "binary_io.h"
 
 template<typename T>
 class DoublyLinkedList {
@@ -341,6 +342,22 @@ public:
         std::swap(m_head, m_tail);
     }
 
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        for (const Node* cur = m_head; cur != nullptr; cur = cur->next)
+            writer.write(cur->data);
+    }
+
+    static DoublyLinkedList<T> deserialize(BinaryReader& reader) {
+        DoublyLinkedList<T> list;
+
+        for (std::size_t i = reader.read_count<T>(); i > 0; --i)
+            list.push_back(reader.read<T>());
+
+        return list;
+    }
+
     [[nodiscard]] constexpr iterator begin() {
         return iterator(m_head);
     }
@@ -0,0 +1,186 @@
+#ifndef STRUCTZ_EPOCH_H
+#define STRUCTZ_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include "vec.h"
+
+// Epoch-based memory reclamation (Fraser, "Practical lock-freedom"). Lock-free structures cannot
+// free a node as soon as they unlink it, since other threads may still be reading it. Instead,
+// readers pin the domain for the duration of each operation, and unlinked memory is retired:
+// it is freed once every thread that was pinned when it was retired has unpinned.
+//
+// A global epoch only advances when every pinned thread has seen the current one, so memory
+// retired in epoch e is unreachable by everyone once the epoch reaches e + 2.
+class EpochDomain {
+    static constexpr std::uint64_t UNPINNED = ~std::uint64_t{0};
+
+    // Retired memory is only scanned once a participant has this much of it.
+    static constexpr std::size_t COLLECT_THRESHOLD = 64;
+
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    // Per-thread bookkeeping. A participant is claimed by one thread at a time, for the length
+    // of a pin; participants are never freed before the domain, so the list can be walked
+    // without locks.
+    struct alignas(64) Participant {
+        std::atomic<bool> claimed{false};
+        std::atomic<std::uint64_t> epoch{UNPINNED};
+        // Only touched by the thread holding the participant.
+        Vec<Retired> limbo;
+        Participant* next = nullptr;
+    };
+
+    std::atomic<std::uint64_t> m_epoch{0};
+    std::atomic<Participant*> m_participants{nullptr};
+
+    [[nodiscard]] static bool try_claim(Participant& participant) {
+        return !participant.claimed.load(std::memory_order_relaxed) &&
+               !participant.claimed.exchange(true, std::memory_order_acquire);
+    }
+
+    // A free participant, or a new one if all are busy. Threads start looking at a different
+    // place of the list to spread out.
+    [[nodiscard]] Participant& claim() {
+        static thread_local const std::size_t hint = std::hash<std::thread::id>()(
+            std::this_thread::get_id());
+
+        Participant* const first = m_participants.load(std::memory_order_acquire);
+        std::size_t count = 0;
+
+        for (Participant* p = first; p != nullptr; p = p->next)
+            ++count;
+
+        if (count > 0) {
+            Participant* start = first;
+            for (std::size_t skip = hint % count; skip > 0; --skip)
+                start = start->next;
+
+            for (Participant* p = start; p != nullptr; p = p->next) {
+                if (try_claim(*p))
+                    return *p;
+            }
+
+            for (Participant* p = first; p != start; p = p->next) {
+                if (try_claim(*p))
+                    return *p;
+            }
+        }
+
+        auto* const participant = new Participant();
+        participant->claimed.store(true, std::memory_order_relaxed);
+        participant->next = m_participants.load(std::memory_order_relaxed);
+
+        while (!m_participants.compare_exchange_weak(participant->next,
+                                                     participant,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+        }
+
+        return *participant;
+    }
+
+    // Moves the global epoch forward if every pinned participant has seen the current one.
+    void try_advance() {
+        std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+
+        for (Participant* p = m_participants.load(std::memory_order_acquire); p != nullptr;
+             p = p->next) {
+            const std::uint64_t seen = p->epoch.load(std::memory_order_seq_cst);
+
+            if (seen != UNPINNED && seen != epoch)
+                return;
+        }
+
+        m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    }
+
+    // Frees what `participant` retired at least two epochs ago.
+    void collect(Participant& participant) {
+        try_advance();
+
+        const std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+        Vec<Retired>& limbo = participant.limbo;
+        std::size_t kept = 0;
+
+        for (std::size_t i = 0; i < limbo.size(); ++i) {
+            if (limbo[i].epoch + 2 <= epoch)
+                limbo[i].deleter(limbo[i].pointer);
+            else
+                limbo[kept++] = limbo[i];
+        }
+
+        while (limbo.size() > kept)
+            limbo.pop();
+    }
+
+public:
+    // Keeps the domain pinned while alive. Memory reachable when the guard was created is not
+    // freed before it is destroyed. Guards are not shared between threads.
+    class Guard {
+        EpochDomain* m_domain;
+        Participant* m_participant;
+
+    public:
+        explicit Guard(EpochDomain& domain)
+            : m_domain(&domain),
+              m_participant(&domain.claim()) {
+            m_participant->epoch.store(domain.m_epoch.load(std::memory_order_seq_cst),
+                                       std::memory_order_seq_cst);
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() {
+            if (m_participant->limbo.size() >= COLLECT_THRESHOLD)
+                m_domain->collect(*m_participant);
+
+            m_participant->epoch.store(UNPINNED, std::memory_order_release);
+            m_participant->claimed.store(false, std::memory_order_release);
+        }
+
+        // Frees `pointer` with `deleter` once no thread can be reading it any more. It must
+        // already be unreachable for threads that pin from now on.
+        void retire(void* const pointer, void (*const deleter)(void*)) {
+            m_participant->limbo.push(
+                {pointer, deleter, m_domain->m_epoch.load(std::memory_order_seq_cst)});
+        }
+
+        template<typename U>
+        void retire(U* const pointer) {
+            retire(pointer, [](void* const p) { delete static_cast<U*>(p); });
+        }
+    };
+
+    EpochDomain() = default;
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // No guard may outlive the domain; everything still retired is freed.
+    ~EpochDomain() {
+        Participant* participant = m_participants.load(std::memory_order_acquire);
+
+        while (participant != nullptr) {
+            for (std::size_t i = 0; i < participant->limbo.size(); ++i)
+                participant->limbo[i].deleter(participant->limbo[i].pointer);
+
+            delete std::exchange(participant, participant->next);
+        }
+    }
+
+    [[nodiscard]] Guard pin() {
+        return Guard(*this);
+    }
+};
+
+#endif
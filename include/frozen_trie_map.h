@@ -0,0 +1,190 @@
+#ifndef STRUCTZ_FROZEN_TRIE_MAP_H
+#define STRUCTZ_FROZEN_TRIE_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "bit_vector.h"
+#include "vec.h"
+
+template<typename T>
+class TrieMap;
+
+// Immutable, pointer-free snapshot of a TrieMap, built by TrieMap::freeze(). The tree shape is a
+// LOUDS bit string (two bits per node) navigated with rank/select, and the edge labels are packed
+// into a single buffer. Every query is const and touches no shared mutable state, so a frozen
+// map can be read from any number of threads without locking.
+template<typename T>
+class FrozenTrieMap {
+    static constexpr std::size_t NONE = -1;
+
+    // For each node in breadth-first order: one 1 per child, then a 0. Node ids are BFS ranks,
+    // so the children of a node are a contiguous id range.
+    BitVector m_louds;
+
+    // One bit per node: whether it holds a value. The value index is the rank of that bit.
+    BitVector m_terminal;
+
+    // One bit per byte of m_labels marking where each label starts, plus a final 1. The root has
+    // no label, so node v's label is the (v - 1)-th one.
+    BitVector m_label_starts;
+
+    std::string m_labels;
+    std::string m_first_bytes;  // First label byte of node v at index v - 1.
+    Vec<T> m_values;
+    std::size_t m_node_count = 0;
+
+    friend class TrieMap<T>;
+
+    [[nodiscard]] static unsigned char byte(const char ch) {
+        return static_cast<unsigned char>(ch);
+    }
+
+    [[nodiscard]] std::pair<std::size_t, std::size_t> children(const std::size_t node) const {
+        const std::size_t start = node == 0 ? 0 : m_louds.select0(node - 1) + 1;
+        const std::size_t end = m_louds.select0(node);
+        const std::size_t first = start - node + 1;
+
+        return {first, first + (end - start)};
+    }
+
+    [[nodiscard]] std::string_view label(const std::size_t node) const {
+        const std::size_t begin = m_label_starts.select1(node - 1);
+        const std::size_t end = m_label_starts.select1(node);
+
+        return std::string_view(m_labels).substr(begin, end - begin);
+    }
+
+    [[nodiscard]] std::size_t find_child(const std::size_t node, const char first) const {
+        const auto [lo, hi] = children(node);
+        const auto begin = m_first_bytes.begin() + static_cast<std::ptrdiff_t>(lo - 1);
+        const auto end = m_first_bytes.begin() + static_cast<std::ptrdiff_t>(hi - 1);
+
+        const auto it = std::lower_bound(
+            begin, end, first, [](const char a, const char b) { return byte(a) < byte(b); });
+
+        if (it == end || *it != first)
+            return NONE;
+
+        return lo + (it - begin);
+    }
+
+    // The node whose path spells exactly `key`, or NONE.
+    [[nodiscard]] std::size_t find_node(const std::string_view key) const {
+        if (m_node_count == 0)
+            return NONE;
+
+        std::size_t cur = 0;
+        std::string_view rest = key;
+
+        while (!rest.empty()) {
+            cur = find_child(cur, rest.front());
+            if (cur == NONE)
+                return NONE;
+
+            const std::string_view edge = label(cur);
+            if (rest.substr(0, edge.size()) != edge)
+                return NONE;
+
+            rest.remove_prefix(edge.size());
+        }
+
+        return cur;
+    }
+
+    [[nodiscard]] const T* value_of(const std::size_t node) const {
+        if (node == NONE || !m_terminal[node])
+            return nullptr;
+
+        return &m_values[m_terminal.rank1(node)];
+    }
+
+public:
+    FrozenTrieMap() = default;
+
+    [[nodiscard]] std::size_t size() const {
+        return m_values.size();
+    }
+
+    [[nodiscard]] bool is_empty() const {
+        return m_values.is_empty();
+    }
+
+    [[nodiscard]] bool contains(const std::string_view key) const {
+        return find(key) != nullptr;
+    }
+
+    [[nodiscard]] const T* find(const std::string_view key) const {
+        return value_of(find_node(key));
+    }
+
+    [[nodiscard]] const T& get(const std::string_view key) const {
+        if (const T* const value = find(key))
+            return *value;
+
+        throw std::out_of_range("Key not found");
+    }
+
+    [[nodiscard]] bool has_prefix(const std::string_view prefix) const {
+        if (is_empty())
+            return false;
+
+        std::size_t cur = 0;
+        std::string_view rest = prefix;
+
+        while (!rest.empty()) {
+            cur = find_child(cur, rest.front());
+            if (cur == NONE)
+                return false;
+
+            const std::string_view edge = label(cur);
+
+            if (rest.size() <= edge.size())
+                return edge.substr(0, rest.size()) == rest;
+
+            if (rest.substr(0, edge.size()) != edge)
+                return false;
+
+            rest.remove_prefix(edge.size());
+        }
+
+        return true;
+    }
+
+    // The longest key that is a prefix of `text`, as its length and a pointer to its value.
+    [[nodiscard]] std::optional<std::pair<std::size_t, const T*>> longest_prefix(
+        const std::string_view text) const {
+        if (m_node_count == 0)
+            return std::nullopt;
+
+        std::optional<std::pair<std::size_t, const T*>> best;
+        std::size_t cur = 0;
+        std::size_t depth = 0;
+
+        if (const T* const value = value_of(cur))
+            best = {0, value};
+
+        while (depth < text.size()) {
+            cur = find_child(cur, text[depth]);
+            if (cur == NONE)
+                break;
+
+            const std::string_view edge = label(cur);
+            if (text.substr(depth, edge.size()) != edge)
+                break;
+
+            depth += edge.size();
+
+            if (const T* const value = value_of(cur))
+                best = {depth, value};
+        }
+
+        return best;
+    }
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include <functional>
 #include <stdexcept>
 #include <utility>
+#include "binary_io.h"
 #include "linked_list.h"
 #include "vec.h"
 
@@ -153,6 +154,37 @@ public:
     void clear() {
         HashMap<K, T>().swap(*this);
     }
+
+    // Stores the entries bucket by bucket; hashes are recomputed on load.
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        for (const auto& bucket : m_buckets) {
+            for (const auto& entry : bucket) {
+                writer.write(entry.key);
+                writer.write(entry.value);
+            }
+        }
+    }
+
+    // Sizes the table for every entry up front, so loading never rehashes because of the fill
+    // factor.
+    static HashMap<K, T> deserialize(BinaryReader& reader) {
+        const std::size_t count = reader.read_count<std::pair<K, T>>();
+        std::size_t capacity = 8;
+
+        while (capacity < 2 * count)
+            capacity *= 2;
+
+        HashMap<K, T> map(capacity);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            K key = reader.read<K>();
+            map.set(std::move(key), reader.read<T>());
+        }
+
+        return map;
+    }
 };
 
 #endif
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <utility>
 #include <variant>
+#include "binary_io.h"
 #include "hash_map.h"
 
 template<typename T>
@@ -41,6 +42,16 @@ public:
     void clear() {
         HashSet<T>().swap(*this);
     }
+
+    void serialize(BinaryWriter& writer) const {
+        map.serialize(writer);
+    }
+
+    static HashSet<T> deserialize(BinaryReader& reader) {
+        HashSet<T> set;
+        set.map = HashMap<T, std::monostate>::deserialize(reader);
+        return set;
+    }
 };
 
 #endif
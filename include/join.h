@@ -0,0 +1,286 @@
+#ifndef STRUCTZ_JOIN_H
+#define STRUCTZ_JOIN_H
+
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <utility>
+#include "compare.h"
+#include "vec.h"
+
+// Whether the set operations of the balanced trees may run their two recursive halves on
+// separate threads.
+enum class Execution : unsigned char {
+    Sequential,
+    Parallel,
+};
+
+// Join-based bulk operations (Blelloch, Ferizovic and Sun, "Just Join for Parallel Ordered
+// Sets"), shared by the balanced trees. A tree only has to provide
+//
+//     Subtree             a root pointer and its rank (height, black height...); empty when
+//                         default-constructed
+//     expose(t, l, r)     the subtrees below the root of the non-empty subtree `t`
+//     join(l, node, r)    a balanced subtree made of `l`, `node` and `r`, whose keys must be
+//                         ordered in that way
+//     destroy(root)       frees a detached subtree
+//
+// and split, union, intersection and difference all follow from join. With inputs of sizes m <= n
+// the set operations take O(m log(n / m + 1)) time.
+namespace join_detail {
+    // Number of recursion levels that fork a thread, enough to keep every hardware thread busy.
+    // Small inputs are not worth the threads.
+    [[nodiscard]] inline unsigned parallel_levels(const Execution execution,
+                                                  const std::size_t size) {
+        if (execution == Execution::Sequential || size < (std::size_t{1} << 14))
+            return 0;
+
+        unsigned levels = 1;
+
+        while ((1U << levels) < 2 * std::thread::hardware_concurrency())
+            ++levels;
+
+        return levels;
+    }
+
+    template<typename Tree>
+    struct Algorithms {
+        using Node = typename Tree::Node;
+        using Subtree = typename Tree::Subtree;
+
+        [[nodiscard]] static std::size_t count(const Node* const root) {
+            std::size_t result = 0;
+            Vec<const Node*> stack;
+            stack.push(root);
+
+            while (!stack.is_empty()) {
+                const Node* const node = stack.pop();
+                if (node == nullptr)
+                    continue;
+
+                ++result;
+                stack.push(node->left);
+                stack.push(node->right);
+            }
+
+            return result;
+        }
+
+        // Splits `tree` into the keys less than and greater than `key`. Returns the node holding
+        // `key`, detached from both halves, or null.
+        template<typename K, typename Compare>
+        static Node* split(const Compare& cmp,
+                           const Subtree& tree,
+                           const K& key,
+                           Subtree& left,
+                           Subtree& right) {
+            if (tree.root == nullptr) {
+                left = Subtree();
+                right = Subtree();
+                return nullptr;
+            }
+
+            Subtree below_left;
+            Subtree below_right;
+            Tree::expose(tree, below_left, below_right);
+
+            const int order = three_way(cmp, key, tree.root->key);
+
+            if (order == 0) {
+                left = below_left;
+                right = below_right;
+                return tree.root;
+            }
+
+            Node* found = nullptr;
+
+            if (order < 0) {
+                Subtree middle;
+                found = split(cmp, below_left, key, left, middle);
+                right = Tree::join(middle, tree.root, below_right);
+            } else {
+                Subtree middle;
+                found = split(cmp, below_right, key, middle, right);
+                left = Tree::join(below_left, tree.root, middle);
+            }
+
+            return found;
+        }
+
+        // Detaches the node with the largest key from the non-empty `tree`.
+        static Node* split_last(const Subtree& tree, Subtree& rest) {
+            Subtree left;
+            Subtree right;
+            Tree::expose(tree, left, right);
+
+            if (right.root == nullptr) {
+                rest = left;
+                return tree.root;
+            }
+
+            Subtree right_rest;
+            Node* const last = split_last(right, right_rest);
+            rest = Tree::join(left, tree.root, right_rest);
+            return last;
+        }
+
+        // Like join(), without a middle node.
+        static Subtree join2(const Subtree& left, const Subtree& right) {
+            if (left.root == nullptr)
+                return right;
+
+            Subtree rest;
+            Node* const last = split_last(left, rest);
+            return Tree::join(rest, last, right);
+        }
+
+        // Runs both functions, the first one on a new thread if `levels` is not zero yet.
+        template<typename F, typename G>
+        static void fork(const unsigned levels, F&& first, G&& second) {
+            if (levels == 0) {
+                first();
+                second();
+                return;
+            }
+
+            auto future = std::async(std::launch::async, std::forward<F>(first));
+            second();
+            future.get();
+        }
+
+        // Union of `a` and `b`, which are both consumed. Where keys match, the node from `b` is
+        // kept and the one from `a` freed; `dropped` counts them.
+        template<typename Compare>
+        static Subtree unite(const Compare& cmp,
+                             const Subtree& a,
+                             const Subtree& b,
+                             std::size_t& dropped,
+                             const unsigned levels) {
+            if (a.root == nullptr)
+                return b;
+
+            if (b.root == nullptr)
+                return a;
+
+            Subtree b_left;
+            Subtree b_right;
+            Tree::expose(b, b_left, b_right);
+
+            Subtree a_left;
+            Subtree a_right;
+            Node* const duplicate = split(cmp, a, b.root->key, a_left, a_right);
+
+            if (duplicate != nullptr) {
+                delete duplicate;
+                ++dropped;
+            }
+
+            const unsigned next = levels > 0 ? levels - 1 : 0;
+            Subtree left;
+            Subtree right;
+            std::size_t dropped_left = 0;
+            std::size_t dropped_right = 0;
+
+            fork(
+                levels,
+                [&] { left = unite(cmp, a_left, b_left, dropped_left, next); },
+                [&] { right = unite(cmp, a_right, b_right, dropped_right, next); });
+
+            dropped += dropped_left + dropped_right;
+            return Tree::join(left, b.root, right);
+        }
+
+        // Entries of `a` whose keys are also in `b`. Both are consumed; `kept` counts the
+        // entries of the result.
+        template<typename Compare>
+        static Subtree intersect(const Compare& cmp,
+                                 const Subtree& a,
+                                 const Subtree& b,
+                                 std::size_t& kept,
+                                 const unsigned levels) {
+            if (a.root == nullptr || b.root == nullptr) {
+                Tree::destroy(a.root);
+                Tree::destroy(b.root);
+                return Subtree();
+            }
+
+            Subtree a_left;
+            Subtree a_right;
+            Tree::expose(a, a_left, a_right);
+
+            Subtree b_left;
+            Subtree b_right;
+            Node* const match = split(cmp, b, a.root->key, b_left, b_right);
+
+            const unsigned next = levels > 0 ? levels - 1 : 0;
+            Subtree left;
+            Subtree right;
+            std::size_t kept_left = 0;
+            std::size_t kept_right = 0;
+
+            fork(
+                levels,
+                [&] { left = intersect(cmp, a_left, b_left, kept_left, next); },
+                [&] { right = intersect(cmp, a_right, b_right, kept_right, next); });
+
+            kept += kept_left + kept_right;
+
+            if (match == nullptr) {
+                delete a.root;
+                return join2(left, right);
+            }
+
+            delete match;
+            ++kept;
+            return Tree::join(left, a.root, right);
+        }
+
+        // Entries of `a` whose keys are not in `b`. Both are consumed; `removed` counts the
+        // entries dropped from `a`.
+        template<typename Compare>
+        static Subtree subtract(const Compare& cmp,
+                                const Subtree& a,
+                                const Subtree& b,
+                                std::size_t& removed,
+                                const unsigned levels) {
+            if (a.root == nullptr) {
+                Tree::destroy(b.root);
+                return Subtree();
+            }
+
+            if (b.root == nullptr)
+                return a;
+
+            Subtree b_left;
+            Subtree b_right;
+            Tree::expose(b, b_left, b_right);
+
+            Subtree a_left;
+            Subtree a_right;
+            Node* const match = split(cmp, a, b.root->key, a_left, a_right);
+
+            delete b.root;
+
+            if (match != nullptr) {
+                delete match;
+                ++removed;
+            }
+
+            const unsigned next = levels > 0 ? levels - 1 : 0;
+            Subtree left;
+            Subtree right;
+            std::size_t removed_left = 0;
+            std::size_t removed_right = 0;
+
+            fork(
+                levels,
+                [&] { left = subtract(cmp, a_left, b_left, removed_left, next); },
+                [&] { right = subtract(cmp, a_right, b_right, removed_right, next); });
+
+            removed += removed_left + removed_right;
+            return join2(left, right);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef STRUCTZ_K_WAY_MERGE_H
+#define STRUCTZ_K_WAY_MERGE_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vec.h"
+
+namespace k_way_merge_detail {
+    // Whether a copy of an Iter still reaches its element after the original is incremented.
+    template<typename Iter, typename = void>
+    struct is_multipass : std::false_type {};
+
+    template<typename Iter>
+    struct is_multipass<Iter,
+                        std::void_t<typename std::iterator_traits<Iter>::iterator_category>>
+        : std::is_base_of<std::forward_iterator_tag,
+                          typename std::iterator_traits<Iter>::iterator_category> {};
+}
+
+// Lazily merges k sorted ranges through a loser tree: each step costs one comparison per level
+// (log k total) and only the source cursors are stored, never the elements themselves.
+template<typename Iter, typename Compare = std::less<>>
+class KWayMerge {
+public:
+    using reference = decltype(*std::declval<Iter&>());
+    using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+
+private:
+    Vec<std::pair<Iter, Iter>> m_sources;
+
+    // m_tree[0] is the current winner, m_tree[1..k) hold the loser of each match. Leaf i is
+    // implicitly node k + i, so node n plays children 2n and 2n + 1.
+    Vec<std::size_t> m_tree;
+    bool m_collapse_duplicates;
+    Compare cmp;
+
+    [[nodiscard]] bool is_exhausted(const std::size_t src) const {
+        return !(m_sources[src].first != m_sources[src].second);
+    }
+
+    // Exhausted sources compare as +infinity.
+    [[nodiscard]] bool less(const std::size_t a, const std::size_t b) {
+        if (is_exhausted(a))
+            return false;
+
+        if (is_exhausted(b))
+            return true;
+
+        return cmp(*m_sources[a].first, *m_sources[b].first);
+    }
+
+    void build() {
+        const std::size_t k = m_sources.size();
+        if (k == 0)
+            return;
+
+        Vec<std::size_t> winners(2 * k);
+        for (std::size_t i = 0; i < k; ++i)
+            winners[k + i] = i;
+
+        for (std::size_t node = k - 1; node > 0; --node) {
+            const std::size_t a = winners[2 * node];
+            const std::size_t b = winners[(2 * node) + 1];
+
+            if (less(b, a)) {
+                winners[node] = b;
+                m_tree[node] = a;
+            } else {
+                winners[node] = a;
+                m_tree[node] = b;
+            }
+        }
+
+        m_tree[0] = winners[1];
+    }
+
+    void replay(std::size_t winner) {
+        const std::size_t k = m_sources.size();
+
+        for (std::size_t node = (k + winner) / 2; node > 0; node /= 2) {
+            if (less(m_tree[node], winner))
+                std::swap(m_tree[node], winner);
+        }
+
+        m_tree[0] = winner;
+    }
+
+    void step() {
+        const std::size_t winner = m_tree[0];
+        ++m_sources[winner].first;
+        replay(winner);
+    }
+
+public:
+    class iterator {
+        KWayMerge* merge;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = typename KWayMerge::value_type;
+        using reference = typename KWayMerge::reference;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+
+        explicit iterator(KWayMerge* const merge)
+            : merge(merge != nullptr && merge->is_empty() ? nullptr : merge) {}
+
+        iterator& operator++() {
+            merge->advance();
+
+            if (merge->is_empty())
+                merge = nullptr;
+
+            return *this;
+        }
+
+        void operator++(int) {
+            ++(*this);
+        }
+
+        bool operator==(const iterator& other) const {
+            return merge == other.merge;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+        reference operator*() const {
+            return merge->peek();
+        }
+    };
+
+    // With `collapse_duplicates`, runs of equivalent elements (within and across sources) are
+    // yielded once.
+    explicit KWayMerge(Vec<std::pair<Iter, Iter>> sources, const bool collapse_duplicates = false)
+        : m_sources(std::move(sources)),
+          m_tree(m_sources.size()),
+          m_collapse_duplicates(collapse_duplicates) {
+        build();
+    }
+
+    [[nodiscard]] bool is_empty() const {
+        return m_tree.is_empty() || is_exhausted(m_tree[0]);
+    }
+
+    [[nodiscard]] reference peek() {
+        if (is_empty())
+            throw std::out_of_range("Merge is exhausted");
+
+        return *m_sources[m_tree[0]].first;
+    }
+
+    void advance() {
+        if (is_empty())
+            throw std::out_of_range("Merge is exhausted");
+
+        if (!m_collapse_duplicates) {
+            step();
+            return;
+        }
+
+        // Forward sources keep their elements in place, so the run is matched against the
+        // winner's element through a saved cursor; single-pass ones need a copy of it.
+        if constexpr (k_way_merge_detail::is_multipass<Iter>::value) {
+            const Iter last = m_sources[m_tree[0]].first;
+            step();
+
+            while (!is_empty() && !cmp(*last, peek()))
+                step();
+        } else {
+            const value_type last = peek();
+            step();
+
+            while (!is_empty() && !cmp(last, peek()))
+                step();
+        }
+    }
+
+    value_type pop() {
+        value_type value = peek();
+        advance();
+        return value;
+    }
+
+    [[nodiscard]] iterator begin() {
+        return iterator(this);
+    }
+
+    [[nodiscard]] iterator end() {
+        return iterator(nullptr);
+    }
+};
+
+#endif
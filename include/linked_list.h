@@ -5,6 +5,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <utility>
+#include "binary_io.h"
 
 template<typename T>
 class LinkedList {
@@ -20,8 +21,12 @@ class LinkedList {
               next(next) {}
     };
 
+public:
+    // Refers to the link holding the current node, so the node can be unlinked or have others
+    // linked before it in O(1). The node owning that link is kept too, to be the new tail.
     class iterator {
-        Node** cur;
+        Node** cur = nullptr;
+        Node* prev = nullptr;
 
         friend class LinkedList<T>;
 
@@ -31,11 +36,15 @@ class LinkedList {
         using pointer = value_type*;
         using reference = value_type&;
 
-        explicit iterator(Node** const head)
-            : cur(head) {}
+        iterator() = default;
+
+        explicit iterator(Node** const link, Node* const prev = nullptr)
+            : cur(link),
+              prev(prev) {}
 
         iterator& operator++() {
-            cur = &(*cur)->next;
+            prev = *cur;
+            cur = &prev->next;
 
             if (*cur == nullptr)
                 cur = nullptr;
@@ -67,7 +76,7 @@ class LinkedList {
     };
 
     class const_iterator {
-        const Node* cur;
+        const Node* cur = nullptr;
 
     public:
         using iterator_category = std::forward_iterator_tag;
@@ -75,6 +84,8 @@ class LinkedList {
         using pointer = value_type*;
         using reference = value_type&;
 
+        const_iterator() = default;
+
         explicit const_iterator(const Node* const head)
             : cur(head) {}
 
@@ -84,7 +95,7 @@ class LinkedList {
         }
 
         const_iterator operator++(int) {
-            iterator retval = *this;
+            const_iterator retval = *this;
             ++(*this);
             return retval;
         }
@@ -106,11 +117,15 @@ class LinkedList {
         }
     };
 
+private:
     Node* m_head = nullptr;
+    // The last node, so that the back is reached in O(1); null when the list is empty.
+    Node* m_tail = nullptr;
     std::size_t m_size = 0;
 
     void swap(LinkedList<T>& other) noexcept {
         std::swap(m_head, other.m_head);
+        std::swap(m_tail, other.m_tail);
         std::swap(m_size, other.m_size);
     }
 
@@ -123,7 +138,7 @@ public:
         Node* other_cur = other.m_head;
 
         while (other_cur != nullptr) {
-            *this_cur = new Node(other_cur->data);
+            *this_cur = m_tail = new Node(other_cur->data);
             this_cur = &(*this_cur)->next;
             other_cur = other_cur->next;
         }
@@ -162,41 +177,32 @@ public:
     }
 
     [[nodiscard]] T& back() {
-        if (m_head == nullptr)
+        if (m_tail == nullptr)
             throw std::runtime_error("list is empty");
 
-        Node* cur = m_head;
-
-        while (cur->next != nullptr)
-            cur = cur->next;
-
-        return cur->data;
+        return m_tail->data;
     }
 
     [[nodiscard]] const T& back() const {
-        if (m_head == nullptr)
+        if (m_tail == nullptr)
             throw std::runtime_error("list is empty");
 
-        Node* cur = m_head;
-
-        while (cur->next != nullptr)
-            cur = cur->next;
-
-        return cur->data;
+        return m_tail->data;
     }
 
     void push_front(T data) {
         m_head = new Node(std::move(data), m_head);
+
+        if (m_tail == nullptr)
+            m_tail = m_head;
+
         ++m_size;
     }
 
     void push_back(T data) {
-        Node** cur = &m_head;
-
-        while (*cur != nullptr)
-            cur = &(*cur)->next;
-
-        *cur = new Node(std::move(data));
+        Node* const node = new Node(std::move(data));
+        (m_tail != nullptr ? m_tail->next : m_head) = node;
+        m_tail = node;
         ++m_size;
     }
 
@@ -204,34 +210,83 @@ public:
         if (m_head == nullptr)
             throw std::runtime_error("list is empty");
 
-        const T data = std::move(m_head->data);
+        T data = std::move(m_head->data);
 
         Node* const new_head = m_head->next;
         delete std::exchange(m_head, new_head);
+
+        if (m_head == nullptr)
+            m_tail = nullptr;
+
         --m_size;
         return data;
     }
 
+    // O(n): the node before the tail is only reachable from the head. DoublyLinkedList pops
+    // from the back in O(1).
     T pop_back() {
-        if (m_head == nullptr)
+        if (m_tail == nullptr)
             throw std::runtime_error("list is empty");
 
         Node** cur = &m_head;
+        Node* prev = nullptr;
 
-        while ((*cur)->next != nullptr)
-            cur = &(*cur)->next;
+        while (*cur != m_tail) {
+            prev = *cur;
+            cur = &prev->next;
+        }
 
-        const T data = std::move((*cur)->data);
+        T data = std::move(m_tail->data);
         delete std::exchange(*cur, nullptr);
+        m_tail = prev;
         --m_size;
         return data;
     }
 
     void remove(const iterator& it) {
+        if (*it.cur == m_tail)
+            m_tail = it.prev;
+
         delete std::exchange(*it.cur, (*it.cur)->next);
         --m_size;
     }
 
+    // Links a new node after the one at `it` and returns an iterator to it.
+    iterator insert_after(const iterator& it, T data) {
+        Node* const node = *it.cur;
+        node->next = new Node(std::move(data), node->next);
+
+        if (node == m_tail)
+            m_tail = node->next;
+
+        ++m_size;
+        return iterator(&node->next, node);
+    }
+
+    // Moves all the nodes of `other` before `it`, or to the back for end(), in O(1). `it` then
+    // refers to the first node moved. Leaves `other` empty.
+    void splice(const iterator& it, LinkedList<T>& other) {
+        if (other.m_head == nullptr || &other == this)
+            return;
+
+        if (it.cur == nullptr) {
+            (m_tail != nullptr ? m_tail->next : m_head) = other.m_head;
+            m_tail = other.m_tail;
+        } else {
+            other.m_tail->next = *it.cur;
+            *it.cur = other.m_head;
+        }
+
+        m_size += other.m_size;
+        other.m_head = other.m_tail = nullptr;
+        other.m_size = 0;
+    }
+
+    // Moves all the nodes of `other` to the back in O(1).
+    void append(LinkedList<T>&& other) {
+        splice(end(), other);
+    }
+
     [[nodiscard]] const T& operator[](const std::size_t index) const {
         if (index >= m_size)
             throw std::out_of_range("list index out of bounds");
@@ -270,6 +325,7 @@ public:
         while (cur != nullptr)
             delete std::exchange(cur, cur->next);
 
+        m_tail = nullptr;
         m_size = 0;
     }
 
@@ -289,7 +345,27 @@ public:
         }
 
         m_head->next = nullptr;
-        m_head = cur_first;
+        m_tail = std::exchange(m_head, cur_first);
+    }
+
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        for (const Node* cur = m_head; cur != nullptr; cur = cur->next)
+            writer.write(cur->data);
+    }
+
+    static LinkedList<T> deserialize(BinaryReader& reader) {
+        LinkedList<T> list;
+        Node** tail = &list.m_head;
+
+        for (std::size_t i = reader.read_count<T>(); i > 0; --i) {
+            *tail = list.m_tail = new Node(reader.read<T>());
+            tail = &(*tail)->next;
+            ++list.m_size;
+        }
+
+        return list;
     }
 
     iterator begin() {
@@ -0,0 +1,57 @@
+#ifndef STRUCTZ_MAPPED_FILE_H
+#define STRUCTZ_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Shared memory mapping of a whole file (POSIX only). Resizing remaps the file, so any pointer
+// into data() is invalidated by resize().
+class MappedFile {
+public:
+    enum class Mode : unsigned char {
+        ReadWrite,
+        ReadOnly,
+    };
+
+private:
+    int m_fd = -1;
+    std::byte* m_data = nullptr;
+    std::size_t m_size = 0;
+    Mode m_mode = Mode::ReadWrite;
+
+    void map();
+
+    void unmap();
+
+    void swap(MappedFile& other) noexcept;
+
+public:
+    MappedFile() = default;
+
+    // In ReadWrite mode, creates an empty file if `path` does not exist. In ReadOnly mode the
+    // file must exist, and writing through data() is not allowed.
+    explicit MappedFile(const std::string& path, Mode mode = Mode::ReadWrite);
+
+    MappedFile(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] std::byte* data();
+
+    [[nodiscard]] const std::byte* data() const;
+
+    void resize(std::size_t new_size);
+
+    // Blocks until all modified pages have been written back to the file.
+    void flush();
+};
+
+#endif
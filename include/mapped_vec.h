@@ -0,0 +1,78 @@
+#ifndef STRUCTZ_MAPPED_VEC_H
+#define STRUCTZ_MAPPED_VEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "binary_io.h"
+#include "mapped_file.h"
+
+// Read-only view of a Vec<T> snapshot (see save_snapshot) that uses the mapped file in place:
+// opening it costs the same regardless of the number of elements, and pages are only read when
+// they are touched.
+template<typename T>
+class MappedVec {
+    static_assert(std::is_trivially_copyable_v<T> && !std::is_empty_v<T>,
+                  "MappedVec elements must be trivially copyable");
+
+    MappedFile m_file;
+    const T* m_data = nullptr;
+    std::size_t m_size = 0;
+
+public:
+    explicit MappedVec(const std::string& path)
+        : m_file(path, MappedFile::Mode::ReadOnly) {
+        const std::byte* const bytes = m_file.data();
+        const std::size_t file_size = m_file.size();
+
+        BinaryReader::check_header(bytes, file_size);
+
+        std::size_t offset = BinaryReader::HEADER_SIZE;
+        std::uint64_t count = 0;
+
+        if (file_size < offset + sizeof(count))
+            throw std::runtime_error("Unexpected end of snapshot");
+
+        std::memcpy(&count, bytes + offset, sizeof(count));
+        offset += sizeof(count);
+        offset += (alignof(T) - offset % alignof(T)) % alignof(T);
+
+        if (offset > file_size || count > (file_size - offset) / sizeof(T))
+            throw std::runtime_error("Unexpected end of snapshot");
+
+        m_data = reinterpret_cast<const T*>(bytes + offset);
+        m_size = count;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] bool is_empty() const {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] const T& operator[](const std::size_t index) const {
+        if (index >= m_size)
+            throw std::out_of_range("Index out of bounds");
+
+        return m_data[index];
+    }
+
+    [[nodiscard]] const T* data() const {
+        return m_data;
+    }
+
+    [[nodiscard]] const T* begin() const {
+        return m_data;
+    }
+
+    [[nodiscard]] const T* end() const {
+        return m_data + m_size;
+    }
+};
+
+#endif
@@ -0,0 +1,596 @@
+#ifndef STRUCTZ_PAGED_BTREE_H
+#define STRUCTZ_PAGED_BTREE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "mapped_file.h"
+#include "vec.h"
+
+// A B-tree stored in a memory-mapped file. Every node is one fixed-size page and children are
+// referenced by page number, so opening an existing file is all it takes to use the tree; the OS
+// page cache decides which nodes stay in memory.
+//
+// Keys and values are copied into the file byte for byte, so both must be trivially copyable.
+// Page 0 holds the file header; freed pages are chained into a free list and reused.
+template<typename K, typename T, typename Compare = std::less<K>, std::size_t PageSize = 4096>
+class PagedBTree {
+    static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<T>,
+                  "PagedBTree keys and values must be trivially copyable");
+
+    using PageId = std::uint64_t;
+
+    // Page 0 is the header, so it doubles as the null child reference.
+    static constexpr PageId NO_PAGE = 0;
+
+    static constexpr std::array<char, 8> MAGIC = {'S', 'T', 'Z', 'B', 'T', 'R', 'E', 'E'};
+
+    struct Header {
+        std::array<char, 8> magic;
+        std::uint64_t page_size;
+        std::uint64_t key_size;
+        std::uint64_t value_size;
+        PageId root;
+        PageId free_list;
+        std::uint64_t page_count;
+        std::uint64_t size;
+    };
+
+    struct Entry {
+        K key;
+        T value;
+    };
+
+    // Largest order whose node fits in a page. Children come before entries so that no padding
+    // is needed between the two arrays.
+    static constexpr std::size_t M =
+        (PageSize - 2 * sizeof(std::uint32_t)) / (sizeof(Entry) + sizeof(PageId));
+
+    struct Node {
+        std::uint32_t size;
+        std::uint32_t is_leaf;
+        std::array<PageId, M> children;
+        std::array<Entry, M - 1> entries;
+    };
+
+    static_assert(M >= 3, "PageSize is too small to hold three children");
+    static_assert(sizeof(Node) <= PageSize && sizeof(Header) <= PageSize);
+
+    static constexpr std::size_t MIN_KEYS = (M + 1) / 2 - 1;
+
+    MappedFile m_file;
+    Compare cmp{};
+
+    [[nodiscard]] Header* header() {
+        return reinterpret_cast<Header*>(m_file.data());
+    }
+
+    [[nodiscard]] const Header* header() const {
+        return reinterpret_cast<const Header*>(m_file.data());
+    }
+
+    [[nodiscard]] Node* node(const PageId id) {
+        return reinterpret_cast<Node*>(m_file.data() + id * PageSize);
+    }
+
+    [[nodiscard]] const Node* node(const PageId id) const {
+        return reinterpret_cast<const Node*>(m_file.data() + id * PageSize);
+    }
+
+    // Invalidates every Node pointer, since growing the file may remap it.
+    PageId allocate_page() {
+        PageId id = header()->free_list;
+
+        if (id != NO_PAGE) {
+            std::memcpy(&header()->free_list, node(id), sizeof(PageId));
+        } else {
+            id = header()->page_count++;
+
+            if ((id + 1) * PageSize > m_file.size())
+                m_file.resize(std::max(2 * m_file.size(), (id + 1) * PageSize));
+        }
+
+        std::memset(node(id), 0, PageSize);
+        return id;
+    }
+
+    void free_page(const PageId id) {
+        std::memcpy(node(id), &header()->free_list, sizeof(PageId));
+        header()->free_list = id;
+    }
+
+    [[nodiscard]] std::size_t lower_bound(const Node* const node, const K& key) const {
+        const auto* const first = node->entries.data();
+        const auto* const it = std::lower_bound(
+            first, first + node->size, key, [this](const Entry& e, const K& k) {
+                return cmp(e.key, k);
+            });
+
+        return it - first;
+    }
+
+    [[nodiscard]] bool matches(const Node* const node, const std::size_t i, const K& key) const {
+        return i < node->size && !cmp(key, node->entries[i].key);
+    }
+
+    [[nodiscard]] const Entry& min_entry(PageId id) const {
+        while (!node(id)->is_leaf)
+            id = node(id)->children[0];
+
+        return node(id)->entries[0];
+    }
+
+    [[nodiscard]] const Entry& max_entry(PageId id) const {
+        while (!node(id)->is_leaf)
+            id = node(id)->children[node(id)->size];
+
+        return node(id)->entries[node(id)->size - 1];
+    }
+
+    void range_search(const PageId id,
+                      Vec<std::pair<K, T>>& out,
+                      const K& begin,
+                      const K& end) const {
+        if (id == NO_PAGE)
+            return;
+
+        const Node* const cur = node(id);
+
+        for (std::size_t i = lower_bound(cur, begin); i <= cur->size; ++i) {
+            range_search(cur->children[i], out, begin, end);
+
+            if (i == cur->size || cmp(end, cur->entries[i].key))
+                break;
+
+            out.push({cur->entries[i].key, cur->entries[i].value});
+        }
+    }
+
+    void swap(PagedBTree& other) noexcept {
+        std::swap(m_file, other.m_file);
+    }
+
+    std::variant<bool, std::pair<Entry, PageId>> insert(const PageId id, const Entry& entry) {
+        if (id == NO_PAGE)
+            return std::pair{entry, NO_PAGE};
+
+        const std::size_t i = lower_bound(node(id), entry.key);
+
+        if (matches(node(id), i, entry.key)) {
+            node(id)->entries[i].value = entry.value;
+            return false;
+        }
+
+        const auto result = insert(node(id)->children[i], entry);
+
+        if (std::holds_alternative<bool>(result))
+            return result;
+
+        const Entry& new_entry = std::get<std::pair<Entry, PageId>>(result).first;
+        const PageId new_child = std::get<std::pair<Entry, PageId>>(result).second;
+
+        if (node(id)->size < M - 1) {
+            Node* const cur = node(id);
+
+            cur->children[cur->size + 1] = cur->children[cur->size];
+
+            for (std::size_t j = cur->size; j > i; --j) {
+                cur->entries[j] = cur->entries[j - 1];
+                cur->children[j] = cur->children[j - 1];
+            }
+
+            cur->entries[i] = new_entry;
+            cur->children[i] = new_child;
+            ++cur->size;
+
+            return true;
+        }
+
+        // The node overflows. Conceptually, the new entry (and its left child) is placed at
+        // position i of an M-entry sequence; the first `mid` entries move to a new left sibling,
+        // entry `mid` is lifted and the rest stay in this page.
+        const PageId left_id = allocate_page();
+        Node* const left = node(left_id);
+        Node* const cur = node(id);
+
+        const auto entry_at = [&](const std::size_t j) -> const Entry& {
+            return j < i ? cur->entries[j] : j == i ? new_entry : cur->entries[j - 1];
+        };
+
+        const auto child_at = [&](const std::size_t j) {
+            return j < i ? cur->children[j] : j == i ? new_child : cur->children[j - 1];
+        };
+
+        const std::size_t mid = (M - 1) / 2;
+        const Entry lifted = entry_at(mid);
+
+        left->is_leaf = cur->is_leaf;
+        left->size = mid;
+
+        for (std::size_t j = 0; j < mid; ++j) {
+            left->entries[j] = entry_at(j);
+            left->children[j] = child_at(j);
+        }
+
+        left->children[mid] = child_at(mid);
+
+        // Sources are never behind their destinations, so the right half can shift in place.
+        const std::size_t right_size = M - 1 - mid;
+
+        for (std::size_t j = 0; j < right_size; ++j) {
+            cur->entries[j] = entry_at(mid + 1 + j);
+            cur->children[j] = child_at(mid + 1 + j);
+        }
+
+        cur->children[right_size] = child_at(M);
+        cur->size = right_size;
+
+        std::fill(cur->children.begin() + right_size + 1, cur->children.end(), NO_PAGE);
+
+        return std::pair{lifted, left_id};
+    }
+
+    void merge_children(Node* const parent, const std::size_t i) {
+        const PageId right_id = parent->children[i + 1];
+        Node* const left = node(parent->children[i]);
+        const Node* const right = node(right_id);
+
+        left->entries[left->size] = parent->entries[i];
+
+        for (std::size_t k = 0; k < right->size; ++k) {
+            left->entries[left->size + 1 + k] = right->entries[k];
+            left->children[left->size + 1 + k] = right->children[k];
+        }
+
+        left->children[left->size + 1 + right->size] = right->children[right->size];
+        left->size += 1 + right->size;
+
+        for (std::size_t k = i; k + 1 < parent->size; ++k) {
+            parent->entries[k] = parent->entries[k + 1];
+            parent->children[k + 1] = parent->children[k + 2];
+        }
+
+        parent->children[parent->size] = NO_PAGE;
+        --parent->size;
+
+        free_page(right_id);
+    }
+
+    enum class DeleteResult : std::uint8_t {
+        NotDeleted,
+        JustDeleted,
+        Deleted,
+    };
+
+    DeleteResult remove(const PageId id, const K& key) {
+        if (id == NO_PAGE)
+            return DeleteResult::NotDeleted;
+
+        Node* const cur = node(id);
+        const std::size_t i = lower_bound(cur, key);
+        const bool found_key = matches(cur, i, key);
+
+        if (found_key && cur->is_leaf) {
+            for (std::size_t k = i; k + 1 < cur->size; ++k)
+                cur->entries[k] = cur->entries[k + 1];
+
+            --cur->size;
+            return DeleteResult::JustDeleted;
+        }
+
+        DeleteResult result{};
+
+        if (found_key) {
+            cur->entries[i] = min_entry(cur->children[i + 1]);
+            result = remove(cur->children[i + 1], cur->entries[i].key);
+        } else {
+            result = remove(cur->children[i], key);
+        }
+
+        if (result != DeleteResult::JustDeleted)
+            return result;
+
+        // The child we descended into may now be short of entries.
+        const std::size_t c = found_key ? i + 1 : i;
+        Node* const mid = node(cur->children[c]);
+
+        if (mid->size >= MIN_KEYS)
+            return DeleteResult::Deleted;
+
+        if (c > 0 && node(cur->children[c - 1])->size > MIN_KEYS) {
+            // Borrow from left
+            Node* const left = node(cur->children[c - 1]);
+
+            mid->children[mid->size + 1] = mid->children[mid->size];
+
+            for (std::size_t k = mid->size; k > 0; --k) {
+                mid->entries[k] = mid->entries[k - 1];
+                mid->children[k] = mid->children[k - 1];
+            }
+
+            mid->entries[0] = cur->entries[c - 1];
+            mid->children[0] = left->children[left->size];
+            cur->entries[c - 1] = left->entries[left->size - 1];
+
+            left->children[left->size] = NO_PAGE;
+            ++mid->size;
+            --left->size;
+
+            return DeleteResult::Deleted;
+        }
+
+        if (c < cur->size && node(cur->children[c + 1])->size > MIN_KEYS) {
+            // Borrow from right
+            Node* const right = node(cur->children[c + 1]);
+
+            mid->entries[mid->size] = cur->entries[c];
+            mid->children[mid->size + 1] = right->children[0];
+            cur->entries[c] = right->entries[0];
+
+            for (std::size_t k = 0; k + 1 < right->size; ++k) {
+                right->entries[k] = right->entries[k + 1];
+                right->children[k] = right->children[k + 1];
+            }
+
+            right->children[right->size - 1] = right->children[right->size];
+            right->children[right->size] = NO_PAGE;
+
+            ++mid->size;
+            --right->size;
+
+            return DeleteResult::Deleted;
+        }
+
+        merge_children(cur, c < cur->size ? c : c - 1);
+
+        return DeleteResult::JustDeleted;
+    }
+
+    [[nodiscard]] std::ptrdiff_t height(PageId id) const {
+        std::ptrdiff_t height = -1;
+
+        while (id != NO_PAGE) {
+            id = node(id)->children[0];
+            ++height;
+        }
+
+        return height;
+    }
+
+public:
+    // The largest number of children a node can have with this page size.
+    static constexpr std::size_t ORDER = M;
+
+    // Opens the tree stored at `path`, creating an empty one if the file does not exist or is
+    // empty. Throws std::runtime_error if the file was written with a different page size or
+    // different key/value sizes.
+    explicit PagedBTree(const std::string& path)
+        : m_file(path) {
+        if (m_file.size() == 0) {
+            m_file.resize(PageSize);
+
+            *header() = Header{
+                MAGIC, PageSize, sizeof(K), sizeof(T), NO_PAGE, NO_PAGE, 1, 0,
+            };
+
+            return;
+        }
+
+        if (m_file.size() < PageSize || header()->magic != MAGIC ||
+            header()->page_size != PageSize || header()->key_size != sizeof(K) ||
+            header()->value_size != sizeof(T) ||
+            header()->page_count * PageSize > m_file.size())
+            throw std::runtime_error("Incompatible B-tree file");
+    }
+
+    PagedBTree(const PagedBTree& other) = delete;
+
+    PagedBTree(PagedBTree&& other) noexcept {
+        swap(other);
+    }
+
+    ~PagedBTree() = default;
+
+    PagedBTree& operator=(const PagedBTree& other) = delete;
+
+    PagedBTree& operator=(PagedBTree&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return header()->size;
+    }
+
+    [[nodiscard]] std::ptrdiff_t height() const {
+        return height(header()->root);
+    }
+
+    [[nodiscard]] bool is_empty() const {
+        return size() == 0;
+    }
+
+    // Pages in use or on the free list, including the header page.
+    [[nodiscard]] std::size_t page_count() const {
+        return header()->page_count;
+    }
+
+    // Checks entry counts, key order (within pages and against the separators above them) and
+    // that all leaves are at the same depth, in a single iterative O(n) pass.
+    [[nodiscard]] bool check_properties() const {
+        const PageId root = header()->root;
+        if (root == NO_PAGE)
+            return true;
+
+        // A page, its depth and the keys its entries must lie strictly between, if any. Reading
+        // never remaps the file, so the bounds can point into other pages.
+        struct Frame {
+            PageId id;
+            std::ptrdiff_t depth;
+            const K* lower;
+            const K* upper;
+        };
+
+        Vec<Frame> stack;
+        stack.push({root, 0, nullptr, nullptr});
+
+        const std::ptrdiff_t leaf_depth = height();
+
+        while (!stack.is_empty()) {
+            const Frame frame = stack.pop();
+            const Node* const cur = node(frame.id);
+            const std::size_t min_entries = frame.id == root ? 1 : MIN_KEYS;
+
+            if (cur->size < min_entries || cur->size > M - 1)
+                return false;
+
+            const K* previous = frame.lower;
+
+            for (std::size_t i = 0; i < cur->size; ++i) {
+                if (previous != nullptr && !cmp(*previous, cur->entries[i].key))
+                    return false;
+
+                previous = &cur->entries[i].key;
+            }
+
+            if (frame.upper != nullptr && !cmp(*previous, *frame.upper))
+                return false;
+
+            if ((cur->is_leaf != 0) != (cur->children[0] == NO_PAGE))
+                return false;
+
+            if (cur->is_leaf) {
+                if (frame.depth != leaf_depth)
+                    return false;
+
+                continue;
+            }
+
+            for (std::size_t i = 0; i <= cur->size; ++i) {
+                if (cur->children[i] == NO_PAGE)
+                    return false;
+
+                stack.push({cur->children[i],
+                            frame.depth + 1,
+                            i == 0 ? frame.lower : &cur->entries[i - 1].key,
+                            i == cur->size ? frame.upper : &cur->entries[i].key});
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool contains_key(const K& key) const {
+        PageId id = header()->root;
+
+        while (id != NO_PAGE) {
+            const Node* const cur = node(id);
+            const std::size_t i = lower_bound(cur, key);
+
+            if (matches(cur, i, key))
+                return true;
+
+            id = cur->children[i];
+        }
+
+        return false;
+    }
+
+    // Returns a copy, since a later insertion may remap the file.
+    [[nodiscard]] T get(const K& key) const {
+        PageId id = header()->root;
+
+        while (id != NO_PAGE) {
+            const Node* const cur = node(id);
+            const std::size_t i = lower_bound(cur, key);
+
+            if (matches(cur, i, key))
+                return cur->entries[i].value;
+
+            id = cur->children[i];
+        }
+
+        throw std::runtime_error("Key not found");
+    }
+
+    [[nodiscard]] Vec<std::pair<K, T>> range_search(const K& begin, const K& end) const {
+        Vec<std::pair<K, T>> out;
+        range_search(header()->root, out, begin, end);
+        return out;
+    }
+
+    [[nodiscard]] K min_key() const {
+        if (is_empty())
+            throw std::runtime_error("BTree is empty");
+
+        return min_entry(header()->root).key;
+    }
+
+    [[nodiscard]] K max_key() const {
+        if (is_empty())
+            throw std::runtime_error("BTree is empty");
+
+        return max_entry(header()->root).key;
+    }
+
+    bool insert(const K& key, const T& value) {
+        const auto result = insert(header()->root, Entry{key, value});
+
+        if (const bool* const inserted = std::get_if<bool>(&result)) {
+            if (*inserted)
+                ++header()->size;
+
+            return *inserted;
+        }
+
+        const auto [new_entry, new_child] = std::get<std::pair<Entry, PageId>>(result);
+
+        const PageId root_id = allocate_page();
+        Node* const new_root = node(root_id);
+
+        new_root->is_leaf = new_child == NO_PAGE;
+        new_root->entries[0] = new_entry;
+        new_root->size = 1;
+
+        new_root->children[0] = new_child;
+        new_root->children[1] = header()->root;
+
+        header()->root = root_id;
+
+        ++header()->size;
+        return true;
+    }
+
+    bool remove(const K& key) {
+        const DeleteResult result = remove(header()->root, key);
+
+        if (result == DeleteResult::NotDeleted)
+            return false;
+
+        const PageId root_id = header()->root;
+
+        if (node(root_id)->size == 0) {
+            header()->root = node(root_id)->children[0];
+            free_page(root_id);
+        }
+
+        --header()->size;
+        return true;
+    }
+
+    // Writes all changes back to the file. Without it they still reach the file eventually, but
+    // are not guaranteed to survive a system crash.
+    void flush() {
+        m_file.flush();
+    }
+};
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef STRUCTZ_PAIRING_HEAP_H
+#define STRUCTZ_PAIRING_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "vec.h"
+
+template<typename T, typename Compare = std::less<>>
+class PairingHeap {
+    struct Node {
+        T value;
+        Node* child = nullptr;
+        Node* sibling = nullptr;
+
+        explicit Node(T value)
+            : value(std::move(value)) {}
+    };
+
+    Node* m_root = nullptr;
+    std::size_t m_size = 0;
+    Compare cmp{};
+
+    // Both nodes must be roots (no siblings).
+    Node* meld(Node* a, Node* b) {
+        if (a == nullptr)
+            return b;
+
+        if (b == nullptr)
+            return a;
+
+        if (cmp(b->value, a->value))
+            std::swap(a, b);
+
+        b->sibling = a->child;
+        a->child = b;
+        return a;
+    }
+
+    // Standard two-pass pairing: meld siblings pairwise left to right, then fold the pairs back
+    // right to left. The pairs are chained through `sibling` in reverse, so no extra storage.
+    Node* merge_pairs(Node* first) {
+        Node* pairs = nullptr;
+
+        while (first != nullptr) {
+            Node* const a = first;
+            Node* const b = a->sibling;
+
+            if (b == nullptr) {
+                a->sibling = pairs;
+                pairs = a;
+                break;
+            }
+
+            first = b->sibling;
+            a->sibling = nullptr;
+            b->sibling = nullptr;
+
+            Node* const melded = meld(a, b);
+            melded->sibling = pairs;
+            pairs = melded;
+        }
+
+        Node* result = nullptr;
+
+        while (pairs != nullptr) {
+            Node* const next = pairs->sibling;
+            pairs->sibling = nullptr;
+            result = meld(result, pairs);
+            pairs = next;
+        }
+
+        return result;
+    }
+
+    void swap(PairingHeap& other) noexcept {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+        std::swap(cmp, other.cmp);
+    }
+
+public:
+    PairingHeap() = default;
+
+    explicit PairingHeap(Compare cmp)
+        : cmp(std::move(cmp)) {}
+
+    PairingHeap(const PairingHeap& other)
+        : m_size(other.m_size),
+          cmp(other.cmp) {
+        Vec<std::pair<Node**, Node*>> stack;
+        stack.push({&m_root, other.m_root});
+
+        while (!stack.is_empty()) {
+            const auto [dest, src] = stack.pop();
+            if (src == nullptr)
+                continue;
+
+            *dest = new Node(src->value);
+            stack.push({&(*dest)->child, src->child});
+            stack.push({&(*dest)->sibling, src->sibling});
+        }
+    }
+
+    PairingHeap(PairingHeap&& other) noexcept {
+        swap(other);
+    }
+
+    ~PairingHeap() {
+        Vec<Node*> stack;
+        stack.push(std::exchange(m_root, nullptr));
+
+        while (!stack.is_empty()) {
+            Node* const node = stack.pop();
+            if (node == nullptr)
+                continue;
+
+            stack.push(node->child);
+            stack.push(node->sibling);
+            delete node;
+        }
+
+        m_size = 0;
+    }
+
+    PairingHeap& operator=(const PairingHeap& other) {
+        PairingHeap(other).swap(*this);
+        return *this;
+    }
+
+    PairingHeap& operator=(PairingHeap&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    void push(T value) {
+        m_root = meld(m_root, new Node(std::move(value)));
+        ++m_size;
+    }
+
+    T pop() {
+        if (m_root == nullptr)
+            throw std::out_of_range("Heap is empty");
+
+        Node* const old_root = std::exchange(m_root, merge_pairs(m_root->child));
+        T value = std::move(old_root->value);
+
+        delete old_root;
+        --m_size;
+
+        return value;
+    }
+
+    T& peek() {
+        if (m_root == nullptr)
+            throw std::out_of_range("Heap is empty");
+
+        return m_root->value;
+    }
+
+    const T& peek() const {
+        if (m_root == nullptr)
+            throw std::out_of_range("Heap is empty");
+
+        return m_root->value;
+    }
+
+    // Takes all elements of `other` in O(1), leaving it empty.
+    void merge(PairingHeap&& other) {
+        m_root = meld(m_root, std::exchange(other.m_root, nullptr));
+        m_size += std::exchange(other.m_size, 0);
+    }
+
+    void clear() {
+        PairingHeap().swap(*this);
+    }
+};
+
+#endif
@@ -0,0 +1,371 @@
+#ifndef STRUCTZ_PERSISTENT_AVL_TREE_H
+#define STRUCTZ_PERSISTENT_AVL_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "compare.h"
+#include "vec.h"
+
+// AVL tree with immutable, reference-counted nodes. An update copies only the O(log n) nodes on
+// the path to the changed key and shares every other node with the previous version, so copying
+// the tree (or calling snapshot()) is O(1) and never affected by later updates.
+//
+// Nodes are never modified after construction, so any number of threads may read and iterate
+// their own snapshots while another thread updates the tree it owns. A single tree object must
+// still not be updated and read concurrently.
+template<typename K, typename T, typename Compare = std::less<K>>
+class PersistentAvlTree {
+    struct Node;
+
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        K key;
+        T value;
+        std::ptrdiff_t height;
+        NodePtr left;
+        NodePtr right;
+
+        Node(K key, T value, NodePtr left, NodePtr right)
+            : key(std::move(key)),
+              value(std::move(value)),
+              height(1 + std::max(PersistentAvlTree::height(left.get()),
+                                  PersistentAvlTree::height(right.get()))),
+              left(std::move(left)),
+              right(std::move(right)) {}
+    };
+
+    NodePtr m_root;
+    std::size_t m_size = 0;
+    Compare cmp{};
+
+    [[nodiscard]] static std::ptrdiff_t height(const Node* const node) {
+        if (node == nullptr)
+            return -1;
+
+        return node->height;
+    }
+
+    [[nodiscard]] static NodePtr make(K key, T value, NodePtr left, NodePtr right) {
+        return std::make_shared<const Node>(
+            std::move(key), std::move(value), std::move(left), std::move(right));
+    }
+
+    // Builds a node out of (possibly unbalanced by one level) subtrees, rotating if needed.
+    [[nodiscard]] static NodePtr balance(K key, T value, NodePtr left, NodePtr right) {
+        const std::ptrdiff_t bf = height(right.get()) - height(left.get());
+
+        if (bf < -1) {
+            const Node* const l = left.get();
+
+            if (height(l->left.get()) >= height(l->right.get()))
+                return make(l->key,
+                            l->value,
+                            l->left,
+                            make(std::move(key), std::move(value), l->right, std::move(right)));
+
+            const Node* const lr = l->right.get();
+
+            return make(lr->key,
+                        lr->value,
+                        make(l->key, l->value, l->left, lr->left),
+                        make(std::move(key), std::move(value), lr->right, std::move(right)));
+        }
+
+        if (bf > 1) {
+            const Node* const r = right.get();
+
+            if (height(r->right.get()) >= height(r->left.get()))
+                return make(r->key,
+                            r->value,
+                            make(std::move(key), std::move(value), std::move(left), r->left),
+                            r->right);
+
+            const Node* const rl = r->left.get();
+
+            return make(rl->key,
+                        rl->value,
+                        make(std::move(key), std::move(value), std::move(left), rl->left),
+                        make(r->key, r->value, rl->right, r->right));
+        }
+
+        return make(std::move(key), std::move(value), std::move(left), std::move(right));
+    }
+
+    [[nodiscard]] const Node* find_node(const K& key) const {
+        const Node* cur = m_root.get();
+
+        while (cur != nullptr) {
+            const int order = three_way(cmp, key, cur->key);
+
+            if (order == 0)
+                return cur;
+
+            cur = order < 0 ? cur->left.get() : cur->right.get();
+        }
+
+        return nullptr;
+    }
+
+    NodePtr insert(const NodePtr& node, K&& key, T&& value, bool& inserted) const {
+        if (node == nullptr) {
+            inserted = true;
+            return make(std::move(key), std::move(value), nullptr, nullptr);
+        }
+
+        const int order = three_way(cmp, key, node->key);
+
+        if (order < 0)
+            return balance(node->key,
+                           node->value,
+                           insert(node->left, std::move(key), std::move(value), inserted),
+                           node->right);
+
+        if (order > 0)
+            return balance(node->key,
+                           node->value,
+                           node->left,
+                           insert(node->right, std::move(key), std::move(value), inserted));
+
+        inserted = false;
+        return make(std::move(key), std::move(value), node->left, node->right);
+    }
+
+    // Returns `node` without its leftmost node, which is stored in `min`. The caller keeps the
+    // original subtree alive, and with it `min`.
+    static NodePtr remove_min(const NodePtr& node, const Node*& min) {
+        if (node->left == nullptr) {
+            min = node.get();
+            return node->right;
+        }
+
+        return balance(node->key, node->value, remove_min(node->left, min), node->right);
+    }
+
+    NodePtr remove(const NodePtr& node, const K& key, bool& removed) const {
+        if (node == nullptr) {
+            removed = false;
+            return nullptr;
+        }
+
+        const int order = three_way(cmp, key, node->key);
+
+        if (order < 0) {
+            NodePtr left = remove(node->left, key, removed);
+            return removed ? balance(node->key, node->value, std::move(left), node->right) : node;
+        }
+
+        if (order > 0) {
+            NodePtr right = remove(node->right, key, removed);
+            return removed ? balance(node->key, node->value, node->left, std::move(right)) : node;
+        }
+
+        removed = true;
+
+        if (node->left == nullptr)
+            return node->right;
+
+        if (node->right == nullptr)
+            return node->left;
+
+        const Node* min = nullptr;
+        NodePtr right = remove_min(node->right, min);
+
+        return balance(min->key, min->value, node->left, std::move(right));
+    }
+
+public:
+    // In-order iterator. It shares ownership of the version it was created from, so it stays
+    // valid after the tree is updated or destroyed.
+    class const_iterator {
+        NodePtr m_root;
+        Vec<const Node*> m_stack;
+
+        void push_left(const Node* node) {
+            while (node != nullptr) {
+                m_stack.push(node);
+                node = node->left.get();
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const K&, const T&>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        const_iterator() = default;
+
+        explicit const_iterator(NodePtr root)
+            : m_root(std::move(root)) {
+            push_left(m_root.get());
+        }
+
+        [[nodiscard]] const K& key() const {
+            return m_stack.last()->key;
+        }
+
+        [[nodiscard]] const T& value() const {
+            return m_stack.last()->value;
+        }
+
+        value_type operator*() const {
+            return {key(), value()};
+        }
+
+        const_iterator& operator++() {
+            const Node* const node = m_stack.pop();
+            push_left(node->right.get());
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            if (m_stack.is_empty() || other.m_stack.is_empty())
+                return m_stack.is_empty() && other.m_stack.is_empty();
+
+            return m_stack.last() == other.m_stack.last();
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    PersistentAvlTree() = default;
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] std::ptrdiff_t height() const {
+        return height(m_root.get());
+    }
+
+    // Checks ordering, balance and the stored heights. Runs iteratively in O(n) time.
+    [[nodiscard]] bool check_properties() const {
+        // A node still to be checked, or whose children have been checked once `done` is set,
+        // and the nodes its key must lie strictly between.
+        struct Frame {
+            const Node* node;
+            const Node* lower;
+            const Node* upper;
+            bool done;
+        };
+
+        Vec<Frame> stack;
+        stack.push({m_root.get(), nullptr, nullptr, false});
+
+        // Results for the subtrees checked so far; a left subtree's comes before its sibling's.
+        Vec<std::ptrdiff_t> heights;
+
+        while (!stack.is_empty()) {
+            const Frame frame = stack.pop();
+            const Node* const node = frame.node;
+
+            if (node == nullptr) {
+                heights.push(-1);
+                continue;
+            }
+
+            if (frame.done) {
+                const std::ptrdiff_t right_height = heights.pop();
+                const std::ptrdiff_t left_height = heights.pop();
+
+                if (node->height != 1 + std::max(left_height, right_height) ||
+                    left_height - right_height > 1 || right_height - left_height > 1)
+                    return false;
+
+                heights.push(node->height);
+                continue;
+            }
+
+            if (frame.lower != nullptr && !cmp(frame.lower->key, node->key))
+                return false;
+
+            if (frame.upper != nullptr && !cmp(node->key, frame.upper->key))
+                return false;
+
+            stack.push({node, frame.lower, frame.upper, true});
+            stack.push({node->right.get(), node, frame.upper, false});
+            stack.push({node->left.get(), frame.lower, node, false});
+        }
+
+        return true;
+    }
+
+    // An immutable view of the current version. Later updates to this tree do not affect it.
+    [[nodiscard]] PersistentAvlTree snapshot() const {
+        return *this;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return find_node(key) != nullptr;
+    }
+
+    [[nodiscard]] const T* find(const K& key) const {
+        const Node* const node = find_node(key);
+        return node != nullptr ? &node->value : nullptr;
+    }
+
+    [[nodiscard]] const T& get(const K& key) const {
+        const Node* const node = find_node(key);
+
+        if (node == nullptr)
+            throw std::out_of_range("key not found");
+
+        return node->value;
+    }
+
+    bool insert(K key, T value) {
+        bool inserted = false;
+        m_root = insert(m_root, std::move(key), std::move(value), inserted);
+
+        if (inserted)
+            ++m_size;
+
+        return inserted;
+    }
+
+    bool remove(const K& key) {
+        bool removed = false;
+        NodePtr root = remove(m_root, key, removed);
+
+        if (!removed)
+            return false;
+
+        m_root = std::move(root);
+        --m_size;
+        return true;
+    }
+
+    void clear() {
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(m_root);
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator();
+    }
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <utility>
+#include "binary_io.h"
 #include "vec.h"
 
 template<typename T>
@@ -69,6 +70,26 @@ public:
     [[nodiscard]] bool is_empty() const {
         return head == tail;
     }
+
+    // Elements are stored from the front to the back.
+    void serialize(BinaryWriter& writer) const {
+        const std::size_t count = size();
+        writer.write_size(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            writer.write(data[(head + i) % data.size()]);
+    }
+
+    static Queue<T> deserialize(BinaryReader& reader) {
+        const std::size_t count = reader.read_count<T>();
+        Queue<T> queue(count + 1);
+
+        for (std::size_t i = 0; i < count; ++i)
+            queue.data[i] = reader.read<T>();
+
+        queue.tail = count;
+        return queue;
+    }
 };
 
 #endif
@@ -0,0 +1,140 @@
+#ifndef STRUCTZ_RADIX_HEAP_H
+#define STRUCTZ_RADIX_HEAP_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vec.h"
+
+// Min-heap for monotone unsigned keys: every pushed key must be at least the last key returned
+// by pop() or peek(). Push is O(1) and pop is amortized O(log C), where C is the key range.
+//
+// With a Value type, every key carries a payload, such as the vertex of a Dijkstra distance:
+// push(key, value) stores the pair and pop() returns it. The payload must be default
+// constructible. Without one, the heap holds bare keys.
+template<typename Key, typename Value = void>
+class RadixHeap {
+    static_assert(std::is_unsigned_v<Key>, "RadixHeap only supports unsigned integer keys");
+
+    static constexpr bool HAS_VALUE = !std::is_void_v<Value>;
+    static constexpr std::size_t BUCKETS = std::numeric_limits<Key>::digits + 1;
+
+public:
+    using value_type = std::conditional_t<HAS_VALUE, std::pair<Key, Value>, Key>;
+
+private:
+    // Bucket 0 holds keys equal to m_last; bucket i holds keys whose highest bit differing from
+    // m_last is bit i - 1. Refilling is logically const, hence mutable.
+    mutable std::array<Vec<value_type>, BUCKETS> m_buckets;
+    mutable Key m_last = 0;
+    std::size_t m_size = 0;
+
+    [[nodiscard]] static Key key_of(const value_type& entry) {
+        if constexpr (HAS_VALUE)
+            return entry.first;
+        else
+            return entry;
+    }
+
+    [[nodiscard]] static std::size_t bit_width(const Key value) {
+        if (value == 0)
+            return 0;
+
+#if defined(__GNUC__) || defined(__clang__)
+        return std::numeric_limits<unsigned long long>::digits -
+               __builtin_clzll(static_cast<unsigned long long>(value));
+#else
+        std::size_t width = 0;
+
+        for (Key rest = value; rest != 0; rest >>= 1)
+            ++width;
+
+        return width;
+#endif
+    }
+
+    [[nodiscard]] static std::size_t bucket_of(const Key key, const Key last) {
+        return bit_width(key ^ last);
+    }
+
+    void insert(value_type entry) {
+        const Key key = key_of(entry);
+
+        if (key < m_last)
+            throw std::invalid_argument("RadixHeap key is smaller than the last extracted key");
+
+        m_buckets[bucket_of(key, m_last)].push(std::move(entry));
+        ++m_size;
+    }
+
+    void refill() const {
+        if (!m_buckets[0].is_empty())
+            return;
+
+        std::size_t i = 1;
+        while (m_buckets[i].is_empty())
+            ++i;
+
+        Vec<value_type> bucket = std::move(m_buckets[i]);
+        m_last = key_of(bucket[0]);
+
+        for (const value_type& entry : bucket)
+            m_last = std::min(m_last, key_of(entry));
+
+        for (value_type& entry : bucket)
+            m_buckets[bucket_of(key_of(entry), m_last)].push(std::move(entry));
+    }
+
+public:
+    RadixHeap() = default;
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    template<typename V = Value, std::enable_if_t<std::is_void_v<V>, int> = 0>
+    void push(const Key key) {
+        insert(key);
+    }
+
+    template<typename V = Value, std::enable_if_t<!std::is_void_v<V>, int> = 0>
+    void push(const Key key, V value) {
+        insert(value_type(key, std::move(value)));
+    }
+
+    value_type pop() {
+        if (m_size == 0)
+            throw std::out_of_range("Heap is empty");
+
+        refill();
+        --m_size;
+
+        return m_buckets[0].pop();
+    }
+
+    const value_type& peek() const {
+        if (m_size == 0)
+            throw std::out_of_range("Heap is empty");
+
+        refill();
+        return m_buckets[0].last();
+    }
+
+    void clear() {
+        for (Vec<value_type>& bucket : m_buckets)
+            bucket.clear();
+
+        m_last = 0;
+        m_size = 0;
+    }
+};
+
+#endif
@@ -1,214 +1,482 @@
 #ifndef STRUCTZ_RED_BLACK_TREE_H
 #define STRUCTZ_RED_BLACK_TREE_H
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include "augment.h"
+#include "binary_io.h"
+#include "compare.h"
+#include "join.h"
+#include "tagged_ptr.h"
 #include "vec.h"
 
-template<typename K, typename T, typename Compare = std::less<K>>
+// Nodes hold no parent pointer and no height: the color lives in the low bit of the right child
+// pointer, and insert/remove rebalance bottom-up along a fixed-size path recorded on the way
+// down.
+//
+// `Augment` maintains per-subtree data (see augment.h). With SubtreeSize, the tree also supports
+// rank(), select() and count_range().
+template<typename K, typename T, typename Compare = std::less<K>, typename Augment = NoAugment>
 class RedBlackTree {
-    enum class Color : std::uint8_t {
-        Red,
-        Black
+    using Data = typename Augment::Data;
+
+    static constexpr bool AUGMENTED = !std::is_empty_v<Data>;
+
+    enum Color : unsigned {
+        Black = 0,
+        Red = 1,
     };
 
-    struct Node {
+    // Index of a child: left (0) or right (1).
+    using Dir = unsigned char;
+
+    struct Node : Data {
         K key;
         T value;
-        Color color;
-        std::size_t height;
-        Node* parent = nullptr;
         Node* left = nullptr;
-        Node* right = nullptr;
+        TaggedPtr<Node> right;  // Tagged with the node's color.
 
-        explicit Node(K key,
-                      T value,
-                      const Color color,
-                      const std::size_t height,
-                      Node* const parent)
+        explicit Node(K key, T value, const Color color)
             : key(std::move(key)),
               value(std::move(value)),
-              color(color),
-              height(height),
-              parent(parent) {}
+              right(nullptr, color) {}
+    };
+
+    // A red-black tree with n nodes is at most 2 log2(n + 1) high.
+    static constexpr std::size_t MAX_DEPTH = 2 * std::numeric_limits<std::size_t>::digits + 1;
+
+    // Ancestors of the node being inserted or removed, and the direction taken at each of them.
+    struct Path {
+        std::array<Node*, MAX_DEPTH> nodes;
+        std::array<Dir, MAX_DEPTH> dirs;
+        std::size_t depth = 0;
+
+        void push(Node* const node, const Dir dir) {
+            nodes[depth] = node;
+            dirs[depth] = dir;
+            ++depth;
+        }
     };
 
     std::size_t m_size = 0;
     Node* m_root = nullptr;
     Compare cmp{};
 
-    [[nodiscard]] constexpr static std::ptrdiff_t height(Node* const node) {
+    [[nodiscard]] static Color color(const Node* const node) {
         if (node == nullptr)
-            return -1;
+            return Black;
 
-        return node->height;
+        return static_cast<Color>(node->right.tag());
     }
 
-    [[nodiscard]] constexpr static Color color(Node* const node) {
-        if (node == nullptr)
-            return Color::Black;
+    static void set_color(Node* const node, const Color color) {
+        node->right.set_tag(color);
+    }
+
+    [[nodiscard]] static Node* child(const Node* const node, const Dir dir) {
+        return dir == 0 ? node->left : node->right.get();
+    }
 
-        return node->color;
+    static void set_child(Node* const node, const Dir dir, Node* const child) {
+        if (dir == 0)
+            node->left = child;
+        else
+            node->right = child;
     }
 
-    [[nodiscard]] constexpr static Node* sibling(Node* const node) {
-        if (node->parent == nullptr)
-            throw std::runtime_error("Node does not have parent");
+    static void update(Node* const node) {
+        Augment::update(static_cast<Data&>(*node), node->key, node->value, node->left, node->right);
+    }
+
+    // Rotates `node` down towards `dir`; its child on the other side takes its place and is
+    // returned.
+    static Node* rotate(Node* const node, const Dir dir) {
+        Node* const up = child(node, !dir);
+
+        set_child(node, !dir, child(up, dir));
+        set_child(up, dir, node);
+
+        update(node);
+        update(up);
 
-        Node* const parent = node->parent;
-        return node == parent->left ? parent->right : parent->left;
+        return up;
     }
 
-    constexpr static void update_height(Node* const node) {
-        node->height = 1 + std::max(height(node->left), height(node->right));
+    // Makes `node` the child that path.nodes[level] used to occupy.
+    void replace_at(const Path& path, const std::size_t level, Node* const node) {
+        if (level == 0)
+            m_root = node;
+        else
+            set_child(path.nodes[level - 1], path.dirs[level - 1], node);
     }
 
-    constexpr static void update_heights_upward(Node* const leaf) {
-        Node* cur = leaf;
+    // Refreshes augmented data on the whole path after the subtree below it changed size.
+    static void update_path(const Path& path) {
+        if constexpr (AUGMENTED) {
+            for (std::size_t i = path.depth; i > 0; --i)
+                update(path.nodes[i - 1]);
+        }
+    }
+
+    template<typename Self>
+    static auto* find_node(Self& self, const K& key) {
+        auto* cur = self.m_root;
 
         while (cur != nullptr) {
-            update_height(cur);
-            cur = cur->parent;
+            const int order = three_way(self.cmp, key, cur->key);
+
+            if (order == 0)
+                return cur;
+
+            cur = child(cur, order > 0);
         }
+
+        return cur;
     }
 
-    static void rotate_left(Node** const x_ptr, Node* const z) {
-        Node* const x = *x_ptr;
+    // `node` was just attached as a red leaf below path.nodes[path.depth - 1].
+    void fix_insert(Path& path, Node* node) {
+        std::size_t level = path.depth;
+
+        while (level >= 2 && color(path.nodes[level - 1]) == Red) {
+            Node* parent = path.nodes[level - 1];
+            Node* const grandpa = path.nodes[level - 2];
+            const Dir side = path.dirs[level - 2];
+            Node* const uncle = child(grandpa, !side);
+
+            if (color(uncle) == Red) {
+                set_color(parent, Black);
+                set_color(uncle, Black);
+                set_color(grandpa, Red);
 
-        *x_ptr = z;
-        (*x_ptr)->parent = x->parent;
+                node = grandpa;
+                level -= 2;
+                continue;
+            }
 
-        x->right = z->left;
-        if (x->right != nullptr)
-            x->right->parent = x;
+            if (path.dirs[level - 1] != side) {
+                // Inner grandchild: turn it into an outer one.
+                set_child(grandpa, side, rotate(parent, side));
+                parent = node;
+            }
 
-        z->left = x;
-        z->left->parent = z;
+            set_color(parent, Black);
+            set_color(grandpa, Red);
+            replace_at(path, level - 2, rotate(grandpa, !side));
+            break;
+        }
 
-        update_heights_upward(x);
+        set_color(m_root, Black);
     }
 
-    static void rotate_right(Node** const x_ptr, Node* const z) {
-        Node* const x = *x_ptr;
+    // A black node was removed below path.nodes[path.depth - 1], leaving that side one black node
+    // short.
+    void fix_remove(Path& path) {
+        std::size_t level = path.depth;
+
+        while (level > 0) {
+            Node* const parent = path.nodes[level - 1];
+            const Dir dir = path.dirs[level - 1];
+            Node* sibling = child(parent, !dir);
+
+            if (color(sibling) == Red) {
+                set_color(sibling, Black);
+                set_color(parent, Red);
+                replace_at(path, level - 1, rotate(parent, dir));
+
+                // The sibling is now the parent's parent.
+                path.nodes[level] = parent;
+                path.dirs[level] = dir;
+                path.nodes[level - 1] = sibling;
+                path.dirs[level - 1] = dir;
+                ++level;
+
+                sibling = child(parent, !dir);
+            }
+
+            if (color(sibling->left) == Black && color(sibling->right) == Black) {
+                set_color(sibling, Red);
+
+                if (color(parent) == Red) {
+                    set_color(parent, Black);
+                    return;
+                }
 
-        *x_ptr = z;
-        (*x_ptr)->parent = x->parent;
+                --level;
+                continue;
+            }
+
+            if (color(child(sibling, !dir)) == Black) {
+                // Only the near nephew is red: rotate it outwards.
+                set_color(child(sibling, dir), Black);
+                set_color(sibling, Red);
+                sibling = rotate(sibling, !dir);
+                set_child(parent, !dir, sibling);
+            }
 
-        x->left = z->right;
-        if (x->left != nullptr)
-            x->left->parent = x;
+            set_color(sibling, color(parent));
+            set_color(parent, Black);
+            set_color(child(sibling, !dir), Black);
+            replace_at(path, level - 1, rotate(parent, dir));
+            return;
+        }
+    }
 
-        z->right = x;
-        z->right->parent = z;
+    // Depth of the deepest level of a balanced tree with `count` nodes. Coloring that level red
+    // and everything above black gives every path the same number of black nodes.
+    [[nodiscard]] static std::size_t red_depth(const std::size_t count) {
+        std::size_t depth = 0;
 
-        update_heights_upward(x);
+        while ((count >> (depth + 1)) != 0)
+            ++depth;
+
+        return depth;
     }
 
-    void swap(RedBlackTree& other) noexcept {
-        std::swap(m_root, other.m_root);
-        std::swap(m_size, other.m_size);
+    // Builds a balanced tree out of entries[first, last), which must be sorted by key.
+    static Node* build(Vec<std::pair<K, T>>& entries,
+                       const std::size_t first,
+                       const std::size_t last,
+                       const std::size_t depth,
+                       const std::size_t bottom) {
+        if (first == last)
+            return nullptr;
+
+        const std::size_t mid = first + (last - first) / 2;
+        const Color color = depth == bottom && depth != 0 ? Red : Black;
+        Node* const node =
+            new Node(std::move(entries[mid].first), std::move(entries[mid].second), color);
+
+        node->left = build(entries, first, mid, depth + 1, bottom);
+        node->right = build(entries, mid + 1, last, depth + 1, bottom);
+        update(node);
+
+        return node;
     }
 
-    [[nodiscard]] constexpr Node** holder(Node* const node) {
-        if (node->parent == nullptr)
-            return &m_root;
+    // Hooks for the join-based operations (see join.h). A subtree's rank is its black height:
+    // the number of black nodes on any path down from its root, the root included.
+    friend struct join_detail::Algorithms<RedBlackTree>;
+    using Join = join_detail::Algorithms<RedBlackTree>;
 
-        if (node == node->parent->left)
-            return &node->parent->left;
+    struct Subtree {
+        Node* root = nullptr;
+        std::ptrdiff_t rank = 0;
+    };
 
-        return &node->parent->right;
+    static void expose(const Subtree& tree, Subtree& left, Subtree& right) {
+        const std::ptrdiff_t below = tree.rank - (color(tree.root) == Black ? 1 : 0);
+        left = {tree.root->left, below};
+        right = {tree.root->right.get(), below};
     }
 
-    void rebalance_from(Node* const leaf) {
-        Node* node = leaf;
+    static Subtree blacken(const Subtree& tree) {
+        if (color(tree.root) == Black)
+            return tree;
 
-        while (node->parent != nullptr) {
-            Node* const parent = node->parent;
+        set_color(tree.root, Black);
+        return {tree.root, tree.rank + 1};
+    }
 
-            if (parent == nullptr) {
-                // Case 3
-                break;
-            }
+    // Joins `low` (black-rooted) and `node` along the `dir` spine of `tall`, which is at least as
+    // black-high as `low`.
+    static Subtree join_spine(const Subtree& tall,
+                              Node* const node,
+                              const Subtree& low,
+                              const Dir dir) {
+        if (tall.rank == low.rank && color(tall.root) == Black) {
+            set_child(node, !dir, tall.root);
+            set_child(node, dir, low.root);
+            set_color(node, Red);
+            update(node);
+
+            return {node, low.rank};
+        }
 
-            if (color(parent) == Color::Black) {
-                // Case 1
-                break;
-            }
+        Subtree sides[2];
+        expose(tall, sides[0], sides[1]);
 
-            Node* const grandpa = parent->parent;
-            if (grandpa == nullptr) {
-                // Case 4
-                parent->color = Color::Black;
-                break;
-            }
+        const Subtree joined = join_spine(sides[dir], node, low, dir);
+        set_child(tall.root, dir, joined.root);
+        update(tall.root);
 
-            Node* const uncle = sibling(parent);
-            if (color(uncle) == Color::Red) {
-                // Case 2
-                parent->color = Color::Black;
-                uncle->color = Color::Black;
-                grandpa->color = Color::Red;
+        if (color(tall.root) == Black && color(joined.root) == Red &&
+            color(child(joined.root, dir)) == Red) {
+            set_color(child(joined.root, dir), Black);
+            return {rotate(tall.root, !dir), tall.rank};
+        }
 
-                node = grandpa;
-                continue;
-            }
+        return {tall.root, tall.rank};
+    }
 
-            if (node == parent->right && parent == grandpa->left) {
-                // Case 5 (left)
-                rotate_left(&grandpa->left, node);
-                node = parent;
-                continue;
-            }
+    static Subtree join(const Subtree& left, Node* const node, const Subtree& right) {
+        const Subtree black_left = blacken(left);
+        const Subtree black_right = blacken(right);
+
+        if (black_left.rank != black_right.rank) {
+            const Dir dir = black_left.rank > black_right.rank ? 1 : 0;
+            const Subtree& tall = dir == 1 ? black_left : black_right;
+            const Subtree& low = dir == 1 ? black_right : black_left;
+
+            Subtree joined = join_spine(tall, node, low, dir);
+
+            if (color(joined.root) == Red && color(child(joined.root, dir)) == Red)
+                joined = blacken(joined);
+
+            return joined;
+        }
+
+        node->left = black_left.root;
+        node->right = black_right.root;
+        set_color(node, Red);
+        update(node);
 
-            if (node == parent->left && parent == grandpa->right) {
-                // Case 5 (right)
-                rotate_right(&grandpa->right, node);
-                node = parent;
+        return {node, black_left.rank};
+    }
+
+    static void destroy(Node* const root) {
+        Vec<Node*> stack;
+        stack.push(root);
+
+        while (!stack.is_empty()) {
+            Node* const node = stack.pop();
+            if (node == nullptr)
                 continue;
-            }
 
-            if (node == parent->left) {
-                // Case 6 (left)
-                rotate_right(holder(grandpa), parent);
-                parent->color = Color::Black;
-                grandpa->color = Color::Red;
-                break;
-            }
+            stack.push(node->left);
+            stack.push(node->right.get());
+            delete node;
+        }
+    }
 
-            if (node == parent->right) {
-                // Case 6 (right)
-                rotate_left(holder(grandpa), parent);
-                parent->color = Color::Black;
-                grandpa->color = Color::Red;
-                break;
-            }
+    [[nodiscard]] Subtree whole() const {
+        std::ptrdiff_t rank = 0;
 
-            throw std::runtime_error("case not found");
+        for (const Node* cur = m_root; cur != nullptr; cur = cur->left) {
+            if (color(cur) == Black)
+                ++rank;
         }
 
-        if (m_root)
-            m_root->color = Color::Black;
+        return {m_root, rank};
     }
 
+    // Takes over the nodes of `tree`, which hold `size` entries.
+    void assign(const Subtree& tree, const std::size_t size) {
+        m_root = tree.root;
+        m_size = size;
+
+        if (m_root != nullptr)
+            set_color(m_root, Black);
+    }
+
+    void swap(RedBlackTree& other) noexcept {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+    }
+
+    // In-order iterator over (key, value) pairs.
+    template<bool IsConst>
+    class basic_iterator {
+        using node_pointer = std::conditional_t<IsConst, const Node*, Node*>;
+        using mapped_type = std::conditional_t<IsConst, const T, T>;
+
+        Vec<node_pointer> m_stack;
+
+        void push_left(node_pointer node) {
+            while (node != nullptr) {
+                m_stack.push(node);
+                node = node->left;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const K&, mapped_type&>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        basic_iterator() = default;
+
+        explicit basic_iterator(const node_pointer root) {
+            push_left(root);
+        }
+
+        [[nodiscard]] const K& key() const {
+            return m_stack.last()->key;
+        }
+
+        [[nodiscard]] mapped_type& value() const {
+            return m_stack.last()->value;
+        }
+
+        value_type operator*() const {
+            return {key(), value()};
+        }
+
+        basic_iterator& operator++() {
+            const node_pointer node = m_stack.pop();
+            push_left(node->right.get());
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            if (m_stack.is_empty() || other.m_stack.is_empty())
+                return m_stack.is_empty() && other.m_stack.is_empty();
+
+            return m_stack.last() == other.m_stack.last();
+        }
+
+        bool operator!=(const basic_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
 public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // Memory taken by each entry, excluding allocator overhead.
+    static constexpr std::size_t NODE_SIZE = sizeof(Node);
+
     RedBlackTree() = default;
 
     RedBlackTree(const RedBlackTree& other)
         : m_size(other.m_size) {
-        Vec<std::tuple<Node**, Node*, Node*>> stack;
-        stack.push({&m_root, other.m_root, nullptr});
+        // Each entry is a node to copy and the parent (and side) it hangs from.
+        Vec<std::tuple<Node*, Dir, const Node*>> stack;
+        stack.push({nullptr, 0, other.m_root});
 
         while (!stack.is_empty()) {
-            const auto [dest, src, parent] = stack.pop();
+            const auto [parent, dir, src] = stack.pop();
             if (src == nullptr)
                 continue;
 
-            *dest = new Node(src->key, src->value, src->color, src->height, parent);
-            stack.push({&(*dest)->left, src->left, *dest});
-            stack.push({&(*dest)->right, src->right, *dest});
+            Node* const node = new Node(src->key, src->value, color(src));
+            static_cast<Data&>(*node) = *src;
+
+            if (parent == nullptr)
+                m_root = node;
+            else
+                set_child(parent, dir, node);
+
+            stack.push({node, 0, src->left});
+            stack.push({node, 1, src->right.get()});
         }
     }
 
@@ -217,19 +485,7 @@ public:
     }
 
     ~RedBlackTree() {
-        Vec<Node*> stack;
-        stack.push(std::exchange(m_root, nullptr));
-
-        while (!stack.is_empty()) {
-            Node* const node = stack.pop();
-            if (node == nullptr)
-                continue;
-
-            stack.push(node->left);
-            stack.push(node->right);
-            delete node;
-        }
-
+        destroy(std::exchange(m_root, nullptr));
         m_size = 0;
     }
 
@@ -251,90 +507,357 @@ public:
         return m_size == 0;
     }
 
-    [[nodiscard]] constexpr std::ptrdiff_t height() const {
-        return height(m_root);
+    // Nodes do not store heights, so this walks the whole tree.
+    [[nodiscard]] std::ptrdiff_t height() const {
+        std::ptrdiff_t result = -1;
+        Vec<std::pair<const Node*, std::ptrdiff_t>> stack;
+        stack.push({m_root, 0});
+
+        while (!stack.is_empty()) {
+            const auto [node, depth] = stack.pop();
+            if (node == nullptr)
+                continue;
+
+            result = std::max(result, depth);
+            stack.push({node->left, depth + 1});
+            stack.push({node->right.get(), depth + 1});
+        }
+
+        return result;
     }
 
-    [[nodiscard]] bool contains(const K& key) const {
-        Node* cur = m_root;
+    // Checks ordering, that no red node has a red child and that every path from the root to a
+    // leaf has the same number of black nodes. Runs iteratively in O(n) time.
+    [[nodiscard]] bool check_properties() const {
+        if (color(m_root) != Black)
+            return false;
 
-        while (cur != nullptr) {
-            if (cur->key == key)
-                return true;
+        // A node still to be checked, or whose children have been checked once `done` is set,
+        // and the nodes its key must lie strictly between.
+        struct Frame {
+            const Node* node;
+            const Node* lower;
+            const Node* upper;
+            bool done;
+        };
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
+        Vec<Frame> stack;
+        stack.push({m_root, nullptr, nullptr, false});
+
+        // Black heights of the subtrees checked so far, each left subtree before its sibling.
+        Vec<std::ptrdiff_t> heights;
+
+        while (!stack.is_empty()) {
+            const Frame frame = stack.pop();
+            const Node* const node = frame.node;
+
+            if (node == nullptr) {
+                heights.push(0);
+                continue;
+            }
+
+            if (frame.done) {
+                const std::ptrdiff_t right_height = heights.pop();
+                const std::ptrdiff_t left_height = heights.pop();
+
+                if (left_height != right_height)
+                    return false;
+
+                heights.push(left_height + (color(node) == Black ? 1 : 0));
+                continue;
+            }
+
+            if (frame.lower != nullptr && !cmp(frame.lower->key, node->key))
+                return false;
+
+            if (frame.upper != nullptr && !cmp(node->key, frame.upper->key))
+                return false;
+
+            if (color(node) == Red && (color(node->left) == Red || color(node->right) == Red))
+                return false;
+
+            stack.push({node, frame.lower, frame.upper, true});
+            stack.push({node->right.get(), node, frame.upper, false});
+            stack.push({node->left, frame.lower, node, false});
         }
 
-        return false;
+        return true;
     }
 
-    [[nodiscard]] const T& get(const K& key) const {
-        Node* cur = m_root;
+    // Data of the whole tree, or null if it is empty.
+    [[nodiscard]] const Data* summary() const {
+        return m_root;
+    }
 
-        while (cur != nullptr) {
-            if (cur->key == key)
-                return cur->value;
+    // Number of keys less than `key`.
+    [[nodiscard]] std::size_t rank(const K& key) const {
+        static_assert(augment_detail::has_size<Data>::value, "rank() requires SubtreeSize");
+        return augment_detail::count_less(m_root, key, false, cmp);
+    }
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
-        }
+    // Entry with the given 0-based position in key order.
+    [[nodiscard]] std::pair<const K&, const T&> select(const std::size_t index) const {
+        static_assert(augment_detail::has_size<Data>::value, "select() requires SubtreeSize");
+        const Node* const node = augment_detail::select<Node>(m_root, index);
+        return {node->key, node->value};
+    }
+
+    // Number of keys in [lo, hi].
+    [[nodiscard]] std::size_t count_range(const K& lo, const K& hi) const {
+        static_assert(augment_detail::has_size<Data>::value, "count_range() requires SubtreeSize");
+
+        if (cmp(hi, lo))
+            return 0;
+
+        return augment_detail::count_less(m_root, hi, true, cmp) -
+               augment_detail::count_less(m_root, lo, false, cmp);
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return find_node(*this, key) != nullptr;
+    }
+
+    [[nodiscard]] const T& get(const K& key) const {
+        const Node* const node = find_node(*this, key);
 
-        throw std::out_of_range("key not found");
+        if (node == nullptr)
+            throw std::out_of_range("key not found");
+
+        return node->value;
     }
 
     [[nodiscard]] T& get(const K& key) {
+        Node* const node = find_node(*this, key);
+
+        if (node == nullptr)
+            throw std::out_of_range("key not found");
+
+        return node->value;
+    }
+
+    bool insert(K key, T value) {
+        Path path;
         Node* cur = m_root;
 
         while (cur != nullptr) {
-            if (cur->key == key)
-                return cur->value;
+            const int order = three_way(cmp, key, cur->key);
 
-            if (cmp(key, cur->key))
-                cur = cur->left;
-            else
-                cur = cur->right;
+            if (order == 0) {
+                cur->value = std::move(value);
+
+                // Aggregates over values must be refreshed up to the root.
+                update(cur);
+                update_path(path);
+
+                return false;
+            }
+
+            const Dir dir = order < 0 ? 0 : 1;
+            path.push(cur, dir);
+            cur = child(cur, dir);
         }
 
-        throw std::out_of_range("key not found");
+        Node* const node = new Node(std::move(key), std::move(value), Red);
+        update(node);
+        replace_at(path, path.depth, node);
+        ++m_size;
+
+        update_path(path);
+        fix_insert(path, node);
+
+        return true;
     }
 
-    bool insert(K key, T value) {
-        Node* parent = nullptr;
-        Node** cur = &m_root;
+    bool remove(const K& key) {
+        Path path;
+        Node* target = m_root;
 
-        while (*cur != nullptr) {
-            if ((*cur)->key == key) {
-                (*cur)->value = std::move(value);
-                return false;
+        while (target != nullptr) {
+            const int order = three_way(cmp, key, target->key);
+            if (order == 0)
+                break;
+
+            const Dir dir = order < 0 ? 0 : 1;
+            path.push(target, dir);
+            target = child(target, dir);
+        }
+
+        if (target == nullptr)
+            return false;
+
+        if (target->left != nullptr && target->right != nullptr) {
+            // Move the successor's entry here and unlink the successor instead.
+            Node* const found = target;
+            path.push(found, 1);
+            target = found->right.get();
+
+            while (target->left != nullptr) {
+                path.push(target, 0);
+                target = target->left;
             }
 
-            parent = *cur;
+            found->key = std::move(target->key);
+            found->value = std::move(target->value);
+        }
+
+        Node* const replacement = target->left != nullptr ? target->left : target->right.get();
+        const Color removed_color = color(target);
 
-            if (cmp(key, (*cur)->key))
-                cur = &(*cur)->left;
+        replace_at(path, path.depth, replacement);
+        delete target;
+        --m_size;
+
+        update_path(path);
+
+        if (removed_color == Black) {
+            if (color(replacement) == Red)
+                set_color(replacement, Black);
             else
-                cur = &(*cur)->right;
+                fix_remove(path);
         }
 
-        *cur = new Node(std::move(key), std::move(value), Color::Red, 0, parent);
-
-        ++m_size;
-        update_heights_upward(parent);
-        rebalance_from(*cur);
+        if (m_root != nullptr)
+            set_color(m_root, Black);
 
         return true;
     }
 
-    // bool remove(const T& key) {}
-
     void clear() {
         RedBlackTree().swap(*this);
     }
+
+    // Moves every entry whose key is not less than `key` into a new tree, which is returned.
+    // Takes O(log n) time with SubtreeSize; otherwise counting the moved entries makes it linear
+    // in their number.
+    RedBlackTree split(const K& key) {
+        Subtree left;
+        Subtree right;
+        Node* const found = Join::split(cmp, whole(), key, left, right);
+
+        if (found != nullptr)
+            right = join(Subtree(), found, right);
+
+        std::size_t moved = 0;
+
+        if constexpr (augment_detail::has_size<Data>::value)
+            moved = augment_detail::size(right.root);
+        else
+            moved = Join::count(right.root);
+
+        RedBlackTree result;
+        result.assign(right, moved);
+        assign(left, m_size - moved);
+
+        return result;
+    }
+
+    // Concatenates two trees in O(log n) time. Every key in `left` must be less than every key
+    // in `right`.
+    static RedBlackTree join(RedBlackTree left, RedBlackTree right) {
+        if (!left.is_empty() && !right.is_empty()) {
+            const Node* last = left.m_root;
+            while (last->right != nullptr)
+                last = last->right;
+
+            const Node* first = right.m_root;
+            while (first->left != nullptr)
+                first = first->left;
+
+            if (!left.cmp(last->key, first->key))
+                throw std::invalid_argument("Joined trees overlap");
+        }
+
+        RedBlackTree result;
+        result.assign(Join::join2(left.whole(), right.whole()), left.m_size + right.m_size);
+
+        left.assign(Subtree(), 0);
+        right.assign(Subtree(), 0);
+
+        return result;
+    }
+
+    // Adds every entry of `other`. Where both trees hold a key, the value from `other` wins, as
+    // with insert().
+    void union_with(RedBlackTree other, const Execution execution = Execution::Sequential) {
+        const std::size_t total = m_size + other.m_size;
+        const unsigned levels = join_detail::parallel_levels(execution, total);
+
+        std::size_t dropped = 0;
+        const Subtree result = Join::unite(cmp, whole(), other.whole(), dropped, levels);
+
+        other.assign(Subtree(), 0);
+        assign(result, total - dropped);
+    }
+
+    // Keeps only the entries whose keys are also in `other`.
+    void intersect_with(RedBlackTree other, const Execution execution = Execution::Sequential) {
+        const unsigned levels = join_detail::parallel_levels(execution, m_size + other.m_size);
+
+        std::size_t kept = 0;
+        const Subtree result = Join::intersect(cmp, whole(), other.whole(), kept, levels);
+
+        other.assign(Subtree(), 0);
+        assign(result, kept);
+    }
+
+    // Removes every entry whose key is in `other`.
+    void difference_with(RedBlackTree other, const Execution execution = Execution::Sequential) {
+        const unsigned levels = join_detail::parallel_levels(execution, m_size + other.m_size);
+
+        std::size_t removed = 0;
+        const Subtree result = Join::subtract(cmp, whole(), other.whole(), removed, levels);
+
+        other.assign(Subtree(), 0);
+        assign(result, m_size - removed);
+    }
+
+    [[nodiscard]] iterator begin() {
+        return iterator(m_root);
+    }
+
+    [[nodiscard]] iterator end() {
+        return iterator();
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(m_root);
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator();
+    }
+
+    // Stores the entries in key order.
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        for (auto it = begin(); it != end(); ++it) {
+            writer.write(it.key());
+            writer.write(it.value());
+        }
+    }
+
+    // Entries arrive sorted, so the tree is rebuilt balanced in linear time instead of being
+    // re-inserted. Keys out of order mean a corrupt snapshot.
+    static RedBlackTree deserialize(BinaryReader& reader) {
+        const std::size_t count = reader.read_count<std::pair<K, T>>();
+        auto entries = Vec<std::pair<K, T>>::with_capacity(count);
+        const Compare cmp{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+            K key = reader.read<K>();
+
+            if (i > 0 && !cmp(entries[i - 1].first, key))
+                throw std::runtime_error("Snapshot keys are out of order");
+
+            entries.push({std::move(key), reader.read<T>()});
+        }
+
+        RedBlackTree tree;
+        tree.m_root = build(entries, 0, count, 0, red_depth(count));
+        tree.m_size = count;
+        return tree;
+    }
 };
 
 #endif
@@ -0,0 +1,357 @@
+#ifndef STRUCTZ_SKIP_LIST_H
+#define STRUCTZ_SKIP_LIST_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vec.h"
+
+// Ordered map kept as a skip list (Pugh): a sorted linked list in which each node also links
+// forward on a random number of higher levels, so a search skips ahead in O(log n) expected
+// steps. Each node is a single allocation holding its entry and its tower of links.
+template<typename K, typename T, typename Compare = std::less<K>>
+class SkipList {
+    // A node reaches level i + 1 with probability 4^-i; 16 levels serve billions of entries.
+    static constexpr std::size_t MAX_LEVEL = 16;
+
+    struct Node {
+        K key;
+        T value;
+        std::size_t level;
+
+        Node(K key, T value, const std::size_t level)
+            : key(std::move(key)),
+              value(std::move(value)),
+              level(level) {}
+
+        // The links live right after the node, in the same allocation.
+        [[nodiscard]] Node** next() {
+            return reinterpret_cast<Node**>(this + 1);
+        }
+
+        [[nodiscard]] Node* const* next() const {
+            return reinterpret_cast<Node* const*>(this + 1);
+        }
+    };
+
+    std::array<Node*, MAX_LEVEL> m_head{};
+    // Number of levels in use, at least one.
+    std::size_t m_level = 1;
+    std::size_t m_size = 0;
+    std::uint64_t m_seed = 0x9E3779B97F4A7C15;
+    Compare cmp{};
+
+    static Node* create(K key, T value, const std::size_t level) {
+        static_assert(alignof(Node) >= alignof(Node*));
+
+        void* const memory = ::operator new(sizeof(Node) + level * sizeof(Node*));
+        Node* node = nullptr;
+
+        try {
+            node = new (memory) Node(std::move(key), std::move(value), level);
+        } catch (...) {
+            ::operator delete(memory);
+            throw;
+        }
+
+        std::uninitialized_fill_n(node->next(), level, nullptr);
+        return node;
+    }
+
+    static void destroy(Node* const node) {
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    // The links leaving `node`, or the head's for null.
+    [[nodiscard]] Node** links(Node* const node) {
+        return node == nullptr ? m_head.data() : node->next();
+    }
+
+    [[nodiscard]] std::size_t random_level() {
+        // xorshift64
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 7;
+        m_seed ^= m_seed << 17;
+
+        std::uint64_t bits = m_seed;
+        std::size_t level = 1;
+
+        while (level < MAX_LEVEL && (bits & 3) == 0) {
+            ++level;
+            bits >>= 2;
+        }
+
+        return level;
+    }
+
+    // First node whose key is not less than `key`, or null. If `preds` is given, it receives the
+    // last node before that one on every level in use (null for the head).
+    template<typename Self>
+    [[nodiscard]] static auto lower_bound(Self& self, const K& key, Node** const preds = nullptr)
+        -> std::conditional_t<std::is_const_v<Self>, const Node*, Node*> {
+        Node* pred = nullptr;
+        // The node that stopped the previous level: it is already known not to be less than
+        // `key`, so it is not compared again.
+        const Node* bound = nullptr;
+
+        for (std::size_t i = self.m_level; i-- > 0;) {
+            Node* next = pred == nullptr ? self.m_head[i] : pred->next()[i];
+
+            while (next != bound && self.cmp(next->key, key)) {
+                pred = next;
+                next = next->next()[i];
+            }
+
+            bound = next;
+
+            if (preds != nullptr)
+                preds[i] = pred;
+        }
+
+        return const_cast<Node*>(bound);
+    }
+
+    template<typename Self>
+    [[nodiscard]] static auto find_node(Self& self, const K& key) {
+        const auto node = lower_bound(self, key);
+        return node != nullptr && !self.cmp(key, node->key) ? node : nullptr;
+    }
+
+    template<typename Self, typename Out>
+    static void range_search(Self& self, Out& out, const K& begin, const K& end) {
+        for (auto node = lower_bound(self, begin); node != nullptr && !self.cmp(end, node->key);
+             node = node->next()[0])
+            out.push({&node->key, &node->value});
+    }
+
+    void swap(SkipList& other) noexcept {
+        std::swap(m_head, other.m_head);
+        std::swap(m_level, other.m_level);
+        std::swap(m_size, other.m_size);
+        std::swap(m_seed, other.m_seed);
+    }
+
+    template<bool IsConst>
+    class basic_iterator {
+        using node_pointer = std::conditional_t<IsConst, const Node*, Node*>;
+        using mapped_type = std::conditional_t<IsConst, const T, T>;
+
+        node_pointer m_node = nullptr;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const K&, mapped_type&>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        basic_iterator() = default;
+
+        explicit basic_iterator(const node_pointer node)
+            : m_node(node) {}
+
+        [[nodiscard]] const K& key() const {
+            return m_node->key;
+        }
+
+        [[nodiscard]] mapped_type& value() const {
+            return m_node->value;
+        }
+
+        value_type operator*() const {
+            return {key(), value()};
+        }
+
+        basic_iterator& operator++() {
+            m_node = m_node->next()[0];
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            return m_node == other.m_node;
+        }
+
+        bool operator!=(const basic_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    SkipList() = default;
+
+    // Keeps the tower heights of `other`, so the copy is shaped the same way.
+    SkipList(const SkipList& other)
+        : m_level(other.m_level),
+          m_size(other.m_size),
+          m_seed(other.m_seed) {
+        std::array<Node*, MAX_LEVEL> tails{};
+
+        for (const Node* node = other.m_head[0]; node != nullptr; node = node->next()[0]) {
+            Node* const copy = create(node->key, node->value, node->level);
+
+            for (std::size_t i = 0; i < copy->level; ++i) {
+                links(tails[i])[i] = copy;
+                tails[i] = copy;
+            }
+        }
+    }
+
+    SkipList(SkipList&& other) noexcept {
+        swap(other);
+    }
+
+    ~SkipList() {
+        Node* node = m_head[0];
+
+        while (node != nullptr)
+            destroy(std::exchange(node, node->next()[0]));
+    }
+
+    SkipList& operator=(const SkipList& other) {
+        SkipList(other).swap(*this);
+        return *this;
+    }
+
+    SkipList& operator=(SkipList&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return find_node(*this, key) != nullptr;
+    }
+
+    [[nodiscard]] T* find(const K& key) {
+        Node* const node = find_node(*this, key);
+        return node == nullptr ? nullptr : &node->value;
+    }
+
+    [[nodiscard]] const T* find(const K& key) const {
+        const Node* const node = find_node(*this, key);
+        return node == nullptr ? nullptr : &node->value;
+    }
+
+    [[nodiscard]] T& get(const K& key) {
+        T* const value = find(key);
+
+        if (value == nullptr)
+            throw std::out_of_range("Key not found");
+
+        return *value;
+    }
+
+    [[nodiscard]] const T& get(const K& key) const {
+        const T* const value = find(key);
+
+        if (value == nullptr)
+            throw std::out_of_range("Key not found");
+
+        return *value;
+    }
+
+    // Entries with keys in [begin, end], in order.
+    [[nodiscard]] Vec<std::pair<const K*, T*>> range_search(const K& begin, const K& end) {
+        Vec<std::pair<const K*, T*>> out;
+        range_search(*this, out, begin, end);
+        return out;
+    }
+
+    [[nodiscard]] Vec<std::pair<const K*, const T*>> range_search(const K& begin,
+                                                                  const K& end) const {
+        Vec<std::pair<const K*, const T*>> out;
+        range_search(*this, out, begin, end);
+        return out;
+    }
+
+    // Inserts or overwrites `key`. Returns whether it was new.
+    bool insert(K key, T value) {
+        std::array<Node*, MAX_LEVEL> preds{};
+        Node* const found = lower_bound(*this, key, preds.data());
+
+        if (found != nullptr && !cmp(key, found->key)) {
+            found->value = std::move(value);
+            return false;
+        }
+
+        const std::size_t level = random_level();
+        Node* const node = create(std::move(key), std::move(value), level);
+
+        // Levels above m_level start at the head, where `preds` is already null.
+        m_level = std::max(m_level, level);
+
+        for (std::size_t i = 0; i < level; ++i) {
+            Node** const pred_links = links(preds[i]);
+            node->next()[i] = pred_links[i];
+            pred_links[i] = node;
+        }
+
+        ++m_size;
+        return true;
+    }
+
+    bool remove(const K& key) {
+        std::array<Node*, MAX_LEVEL> preds{};
+        Node* const node = lower_bound(*this, key, preds.data());
+
+        if (node == nullptr || cmp(key, node->key))
+            return false;
+
+        for (std::size_t i = 0; i < node->level; ++i)
+            links(preds[i])[i] = node->next()[i];
+
+        destroy(node);
+
+        while (m_level > 1 && m_head[m_level - 1] == nullptr)
+            --m_level;
+
+        --m_size;
+        return true;
+    }
+
+    void clear() {
+        SkipList().swap(*this);
+    }
+
+    [[nodiscard]] iterator begin() {
+        return iterator(m_head[0]);
+    }
+
+    [[nodiscard]] iterator end() {
+        return iterator(nullptr);
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(m_head[0]);
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator(nullptr);
+    }
+};
+
+#endif
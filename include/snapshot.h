@@ -0,0 +1,37 @@
+#ifndef STRUCTZ_SNAPSHOT_H
+#define STRUCTZ_SNAPSHOT_H
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "binary_io.h"
+
+// Writes `container` to `path` as a snapshot file: a header followed by container.serialize().
+template<typename Container>
+void save_snapshot(const Container& container, const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Cannot open snapshot file");
+
+    BinaryWriter writer(out);
+    writer.write_header();
+    container.serialize(writer);
+
+    out.flush();
+    if (!out)
+        throw std::runtime_error("Failed to write snapshot");
+}
+
+// Rebuilds a container from a file written by save_snapshot.
+template<typename Container>
+[[nodiscard]] Container load_snapshot(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Cannot open snapshot file");
+
+    BinaryReader reader(in);
+    reader.read_header();
+    return Container::deserialize(reader);
+}
+
+#endif
@@ -0,0 +1,431 @@
+#ifndef STRUCTZ_SPLAY_TREE_H
+#define STRUCTZ_SPLAY_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "compare.h"
+#include "vec.h"
+
+// Self-adjusting binary search tree (Sleator and Tarjan). Every access through a non-const tree
+// splays the key to the root, so recently and frequently used keys stay a few levels down: on
+// skewed workloads lookups cost about the entropy of the access distribution instead of log n,
+// and any sequence of operations takes O(log n) amortized time each.
+//
+// Lookups through a const tree leave its shape alone, so they do not adapt but are safe to run
+// concurrently. Nodes have no parent pointers and splaying is top-down, so nothing recurses.
+template<typename K, typename T, typename Compare = std::less<K>>
+class SplayTree {
+    struct Node {
+        K key;
+        T value;
+        Node* left = nullptr;
+        Node* right = nullptr;
+
+        Node(K key, T value)
+            : key(std::move(key)),
+              value(std::move(value)) {}
+    };
+
+    Node* m_root = nullptr;
+    std::size_t m_size = 0;
+    Compare cmp{};
+
+    // Brings the node holding `key`, or the last node on its search path, to the root. The
+    // nodes passed on the way down are gathered into a left tree of smaller keys and a right
+    // tree of larger ones, which become the new root's subtrees. Returns how `key` compares to
+    // the new root's key; the tree must not be empty.
+    int splay(const K& key) {
+        Node* left_tree = nullptr;
+        Node* right_tree = nullptr;
+        // Where the next node joining each side tree is hung: below its largest (respectively
+        // smallest) node so far.
+        Node** left_slot = &left_tree;
+        Node** right_slot = &right_tree;
+        Node* cur = m_root;
+        int order = three_way(cmp, key, cur->key);
+
+        // Each comparison against a child is kept for when the descent moves on to it, so no
+        // node is compared twice.
+        while (order != 0) {
+            if (order < 0) {
+                if (cur->left == nullptr)
+                    break;
+
+                order = three_way(cmp, key, cur->left->key);
+
+                if (order < 0) {
+                    Node* const left = cur->left;
+                    cur->left = left->right;
+                    left->right = cur;
+                    cur = left;
+
+                    if (cur->left == nullptr)
+                        break;
+
+                    *right_slot = cur;
+                    right_slot = &cur->left;
+                    cur = cur->left;
+                    order = three_way(cmp, key, cur->key);
+                } else {
+                    *right_slot = cur;
+                    right_slot = &cur->left;
+                    cur = cur->left;
+                }
+            } else {
+                if (cur->right == nullptr)
+                    break;
+
+                order = three_way(cmp, key, cur->right->key);
+
+                if (order > 0) {
+                    Node* const right = cur->right;
+                    cur->right = right->left;
+                    right->left = cur;
+                    cur = right;
+
+                    if (cur->right == nullptr)
+                        break;
+
+                    *left_slot = cur;
+                    left_slot = &cur->right;
+                    cur = cur->right;
+                    order = three_way(cmp, key, cur->key);
+                } else {
+                    *left_slot = cur;
+                    left_slot = &cur->right;
+                    cur = cur->right;
+                }
+            }
+        }
+
+        *left_slot = cur->left;
+        *right_slot = cur->right;
+        cur->left = left_tree;
+        cur->right = right_tree;
+        m_root = cur;
+
+        return order;
+    }
+
+    // Descends without splaying.
+    [[nodiscard]] const Node* find_node(const K& key) const {
+        const Node* cur = m_root;
+
+        while (cur != nullptr) {
+            const int order = three_way(cmp, key, cur->key);
+
+            if (order == 0)
+                return cur;
+
+            cur = order < 0 ? cur->left : cur->right;
+        }
+
+        return nullptr;
+    }
+
+    // Splays `key` and returns the root if it holds it.
+    [[nodiscard]] Node* access(const K& key) {
+        if (m_root == nullptr || splay(key) != 0)
+            return nullptr;
+
+        return m_root;
+    }
+
+    void swap(SplayTree& other) noexcept {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+    }
+
+    // In-order iterator over (key, value) pairs.
+    template<bool IsConst>
+    class basic_iterator {
+        using node_pointer = std::conditional_t<IsConst, const Node*, Node*>;
+        using mapped_type = std::conditional_t<IsConst, const T, T>;
+
+        Vec<node_pointer> m_stack;
+
+        void push_left(node_pointer node) {
+            while (node != nullptr) {
+                m_stack.push(node);
+                node = node->left;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const K&, mapped_type&>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        basic_iterator() = default;
+
+        explicit basic_iterator(const node_pointer root) {
+            push_left(root);
+        }
+
+        [[nodiscard]] const K& key() const {
+            return m_stack.last()->key;
+        }
+
+        [[nodiscard]] mapped_type& value() const {
+            return m_stack.last()->value;
+        }
+
+        value_type operator*() const {
+            return {key(), value()};
+        }
+
+        basic_iterator& operator++() {
+            const node_pointer node = m_stack.pop();
+            push_left(node->right);
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            if (m_stack.is_empty() || other.m_stack.is_empty())
+                return m_stack.is_empty() && other.m_stack.is_empty();
+
+            return m_stack.last() == other.m_stack.last();
+        }
+
+        bool operator!=(const basic_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    SplayTree() = default;
+
+    SplayTree(const SplayTree& other) {
+        Vec<std::pair<Node**, const Node*>> stack;
+        stack.push({&m_root, other.m_root});
+
+        while (!stack.is_empty()) {
+            const auto [dest, src] = stack.pop();
+            if (src == nullptr)
+                continue;
+
+            *dest = new Node(src->key, src->value);
+            stack.push({&(*dest)->left, src->left});
+            stack.push({&(*dest)->right, src->right});
+        }
+
+        m_size = other.m_size;
+    }
+
+    SplayTree(SplayTree&& other) noexcept {
+        swap(other);
+    }
+
+    ~SplayTree() {
+        Vec<Node*> stack;
+        stack.push(std::exchange(m_root, nullptr));
+
+        while (!stack.is_empty()) {
+            Node* const node = stack.pop();
+            if (node == nullptr)
+                continue;
+
+            stack.push(node->left);
+            stack.push(node->right);
+            delete node;
+        }
+
+        m_size = 0;
+    }
+
+    SplayTree& operator=(const SplayTree& other) {
+        SplayTree(other).swap(*this);
+        return *this;
+    }
+
+    SplayTree& operator=(SplayTree&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    // Walks the whole tree without recursion; a splay tree may briefly be a long chain.
+    [[nodiscard]] std::ptrdiff_t height() const {
+        std::ptrdiff_t result = -1;
+        Vec<std::pair<const Node*, std::ptrdiff_t>> stack;
+        stack.push({m_root, 0});
+
+        while (!stack.is_empty()) {
+            const auto [node, depth] = stack.pop();
+            if (node == nullptr)
+                continue;
+
+            result = std::max(result, depth);
+            stack.push({node->left, depth + 1});
+            stack.push({node->right, depth + 1});
+        }
+
+        return result;
+    }
+
+    // Checks that the keys are in order and that size() matches the number of nodes, in one
+    // iterative O(n) pass.
+    [[nodiscard]] bool check_properties() const {
+        std::size_t count = 0;
+        const Node* previous = nullptr;
+        Vec<const Node*> stack;
+        const Node* cur = m_root;
+
+        while (cur != nullptr || !stack.is_empty()) {
+            while (cur != nullptr) {
+                stack.push(cur);
+                cur = cur->left;
+            }
+
+            const Node* const node = stack.pop();
+
+            if (previous != nullptr && !cmp(previous->key, node->key))
+                return false;
+
+            previous = node;
+            ++count;
+            cur = node->right;
+        }
+
+        return count == m_size;
+    }
+
+    // The key at the root: the one accessed last, unless it has been removed since.
+    [[nodiscard]] const K* root_key() const {
+        return m_root == nullptr ? nullptr : &m_root->key;
+    }
+
+    [[nodiscard]] bool contains(const K& key) {
+        return access(key) != nullptr;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return find_node(key) != nullptr;
+    }
+
+    [[nodiscard]] T* find(const K& key) {
+        Node* const node = access(key);
+        return node == nullptr ? nullptr : &node->value;
+    }
+
+    [[nodiscard]] const T* find(const K& key) const {
+        const Node* const node = find_node(key);
+        return node == nullptr ? nullptr : &node->value;
+    }
+
+    [[nodiscard]] T& get(const K& key) {
+        T* const value = find(key);
+
+        if (value == nullptr)
+            throw std::out_of_range("Key not found");
+
+        return *value;
+    }
+
+    [[nodiscard]] const T& get(const K& key) const {
+        const T* const value = find(key);
+
+        if (value == nullptr)
+            throw std::out_of_range("Key not found");
+
+        return *value;
+    }
+
+    // Inserts or overwrites `key`, which ends up at the root. Returns whether it was new.
+    bool insert(K key, T value) {
+        if (m_root == nullptr) {
+            m_root = new Node(std::move(key), std::move(value));
+            ++m_size;
+            return true;
+        }
+
+        const int order = splay(key);
+
+        if (order == 0) {
+            m_root->value = std::move(value);
+            return false;
+        }
+
+        Node* const node = new Node(std::move(key), std::move(value));
+
+        if (order < 0) {
+            node->left = std::exchange(m_root->left, nullptr);
+            node->right = m_root;
+        } else {
+            node->right = std::exchange(m_root->right, nullptr);
+            node->left = m_root;
+        }
+
+        m_root = node;
+        ++m_size;
+
+        return true;
+    }
+
+    bool remove(const K& key) {
+        Node* const node = access(key);
+
+        if (node == nullptr)
+            return false;
+
+        if (node->left == nullptr) {
+            m_root = node->right;
+        } else {
+            // Every key on the left is smaller, so splaying `key` there lifts the largest of them
+            // to the top, leaving its right side free for the other subtree.
+            m_root = node->left;
+            splay(key);
+            m_root->right = node->right;
+        }
+
+        delete node;
+        --m_size;
+
+        return true;
+    }
+
+    void clear() {
+        SplayTree().swap(*this);
+    }
+
+    [[nodiscard]] iterator begin() {
+        return iterator(m_root);
+    }
+
+    [[nodiscard]] iterator end() {
+        return iterator(nullptr);
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(m_root);
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator(nullptr);
+    }
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include <utility>
+#include "binary_io.h"
 #include "linked_list.h"
 
 template<typename T>
@@ -40,6 +41,17 @@ public:
     [[nodiscard]] bool is_empty() const {
         return list.is_empty();
     }
+
+    // Elements are stored from the top down.
+    void serialize(BinaryWriter& writer) const {
+        list.serialize(writer);
+    }
+
+    static Stack<T> deserialize(BinaryReader& reader) {
+        Stack<T> stack;
+        stack.list = LinkedList<T>::deserialize(reader);
+        return stack;
+    }
 };
 
 #endif
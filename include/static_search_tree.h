@@ -0,0 +1,153 @@
+#ifndef STRUCTZ_STATIC_SEARCH_TREE_H
+#define STRUCTZ_STATIC_SEARCH_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vec.h"
+
+// Immutable sorted map laid out in Eytzinger (breadth-first) order: the children of slot k are
+// slots 2k and 2k + 1. A lookup walks a complete binary tree with no pointers to chase, the
+// first levels share a few cache lines, and the descendants four levels down sit next to each
+// other, so they are prefetched while the current level is compared. The descent itself has no
+// data-dependent branches.
+template<typename K, typename T, typename Compare = std::less<K>>
+class StaticSearchTree {
+    template<typename Container, typename = void>
+    struct is_iterable : std::false_type {};
+
+    template<typename Container>
+    struct is_iterable<Container, std::void_t<decltype(std::declval<const Container&>().begin())>>
+        : std::true_type {};
+
+    // Prefetching slot PREFETCH_STRIDE * k fetches the line holding the descendants of slot k a
+    // few levels down.
+    static constexpr std::size_t PREFETCH_STRIDE = sizeof(K) < 64 ? 64 / sizeof(K) : 1;
+
+    // Slot 0 is unused, so that the root is slot 1.
+    Vec<K> m_keys;
+    Vec<T> m_values;
+    std::size_t m_size = 0;
+    Compare cmp{};
+
+    static void prefetch([[maybe_unused]] const void* const address) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#endif
+    }
+
+    // Moves entries[next...] into the subtree rooted at `slot`, in order.
+    void fill(Vec<std::pair<K, T>>& entries, std::size_t& next, const std::size_t slot) {
+        if (slot > m_size)
+            return;
+
+        fill(entries, next, 2 * slot);
+
+        m_keys[slot] = std::move(entries[next].first);
+        m_values[slot] = std::move(entries[next].second);
+        ++next;
+
+        fill(entries, next, 2 * slot + 1);
+    }
+
+    // Slot of the first key not less than `key`, or 0 if there is none.
+    [[nodiscard]] std::size_t lower_bound_slot(const K& key) const {
+        const K* const keys = m_keys.begin();
+        const auto base = reinterpret_cast<std::uintptr_t>(keys);
+        std::size_t slot = 1;
+
+        while (slot <= m_size) {
+            prefetch(reinterpret_cast<const void*>(base + PREFETCH_STRIDE * slot * sizeof(K)));
+            slot = 2 * slot + static_cast<std::size_t>(cmp(keys[slot], key));
+        }
+
+        // Every right turn taken after the last left one led to smaller keys; the last left turn
+        // was taken at the answer.
+        while ((slot & 1) != 0)
+            slot >>= 1;
+
+        return slot >> 1;
+    }
+
+public:
+    StaticSearchTree() = default;
+
+    // `entries` must be sorted by key, without duplicates.
+    explicit StaticSearchTree(Vec<std::pair<K, T>> entries)
+        : m_keys(entries.size() + 1),
+          m_values(entries.size() + 1),
+          m_size(entries.size()) {
+        for (std::size_t i = 1; i < m_size; ++i) {
+            if (!cmp(entries[i - 1].first, entries[i].first))
+                throw std::invalid_argument("Entries are not sorted by key");
+        }
+
+        std::size_t next = 0;
+        fill(entries, next, 1);
+    }
+
+    // Copies the entries of an ordered container: anything whose iterators yield (key, value)
+    // pairs in key order, or a BTree.
+    template<typename Container>
+    static StaticSearchTree from(const Container& container) {
+        auto entries = Vec<std::pair<K, T>>::with_capacity(container.size());
+
+        if constexpr (is_iterable<Container>::value) {
+            for (auto it = container.begin(); it != container.end(); ++it) {
+                const auto& entry = *it;
+                entries.push({entry.first, entry.second});
+            }
+        } else if (!container.is_empty()) {
+            for (const auto& [key, value] :
+                 container.range_search(container.min_key(), container.max_key()))
+                entries.push({*key, *value});
+        }
+
+        return StaticSearchTree(std::move(entries));
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    [[nodiscard]] const T* find(const K& key) const {
+        const std::size_t slot = lower_bound_slot(key);
+
+        if (slot == 0 || cmp(key, m_keys.begin()[slot]))
+            return nullptr;
+
+        return m_values.begin() + slot;
+    }
+
+    [[nodiscard]] const T& get(const K& key) const {
+        const T* const value = find(key);
+
+        if (value == nullptr)
+            throw std::out_of_range("key not found");
+
+        return *value;
+    }
+
+    // The entry with the smallest key not less than `key`, or a pair of nulls.
+    [[nodiscard]] std::pair<const K*, const T*> lower_bound(const K& key) const {
+        const std::size_t slot = lower_bound_slot(key);
+
+        if (slot == 0)
+            return {nullptr, nullptr};
+
+        return {m_keys.begin() + slot, m_values.begin() + slot};
+    }
+};
+
+#endif
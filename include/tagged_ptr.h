@@ -0,0 +1,52 @@
+#ifndef STRUCTZ_TAGGED_PTR_H
+#define STRUCTZ_TAGGED_PTR_H
+
+#include <cstdint>
+
+// Pointer whose low `Bits` bits, which are always zero for a sufficiently aligned T, hold a small
+// tag instead. Tree nodes use it to store their color or balance factor without growing.
+template<typename T, unsigned Bits = 1>
+class TaggedPtr {
+    static constexpr std::uintptr_t TAG_MASK = (std::uintptr_t{1} << Bits) - 1;
+
+    std::uintptr_t m_bits = 0;
+
+    static std::uintptr_t address(T* const ptr) {
+        static_assert(alignof(T) > TAG_MASK, "T is not aligned enough to hold the tag");
+        return reinterpret_cast<std::uintptr_t>(ptr);
+    }
+
+public:
+    TaggedPtr() = default;
+
+    TaggedPtr(T* const ptr, const unsigned tag = 0)
+        : m_bits(address(ptr) | (tag & TAG_MASK)) {}
+
+    [[nodiscard]] T* get() const {
+        return reinterpret_cast<T*>(m_bits & ~TAG_MASK);
+    }
+
+    [[nodiscard]] unsigned tag() const {
+        return static_cast<unsigned>(m_bits & TAG_MASK);
+    }
+
+    // Replaces the pointer and keeps the tag.
+    TaggedPtr& operator=(T* const ptr) {
+        m_bits = address(ptr) | (m_bits & TAG_MASK);
+        return *this;
+    }
+
+    void set_tag(const unsigned tag) {
+        m_bits = (m_bits & ~TAG_MASK) | (tag & TAG_MASK);
+    }
+
+    T* operator->() const {
+        return get();
+    }
+
+    operator T*() const {
+        return get();
+    }
+};
+
+#endif
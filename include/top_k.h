@@ -0,0 +1,104 @@
+#ifndef STRUCTZ_TOP_K_H
+#define STRUCTZ_TOP_K_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "binary_heap.h"
+#include "vec.h"
+
+// Keeps the k greatest elements (according to Compare) seen so far, in O(k) memory. The weakest
+// kept element sits at the top of the inner heap, so a rejected element costs one comparison.
+template<typename T, typename Compare = std::less<>>
+class TopK {
+    BinaryHeap<T, Compare> m_heap;
+    std::size_t m_k;
+    Compare cmp;
+
+public:
+    explicit TopK(const std::size_t k)
+        : m_k(k) {}
+
+    [[nodiscard]] constexpr std::size_t capacity() const {
+        return m_k;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_heap.size();
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_heap.is_empty();
+    }
+
+    [[nodiscard]] constexpr bool is_full() const {
+        return m_heap.size() >= m_k;
+    }
+
+    // The weakest element currently kept; anything not greater than it is rejected once full.
+    [[nodiscard]] const T& peek() const {
+        return m_heap.peek();
+    }
+
+    bool push(T value) {
+        if (!is_full()) {
+            m_heap.push(std::move(value));
+            return true;
+        }
+
+        if (m_k == 0 || !cmp(m_heap.peek(), value))
+            return false;
+
+        m_heap.replace_top(std::move(value));
+        return true;
+    }
+
+    template<typename InputIt>
+    void push_all(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            push(*first);
+    }
+
+    // Merging a TopK into itself keeps it as it is.
+    void merge(const TopK& other) {
+        if (&other == this)
+            return;
+
+        push_all(other.m_heap.begin(), other.m_heap.end());
+    }
+
+    void merge(TopK&& other) {
+        if (&other == this)
+            return;
+
+        for (T& el : other.m_heap)
+            push(std::move(el));
+
+        other.clear();
+    }
+
+    // Drains the kept elements, greatest first.
+    [[nodiscard]] Vec<T> into_sorted_vec() {
+        Vec<T> result(m_heap.size());
+
+        for (std::size_t i = result.size(); i > 0; --i)
+            result[i - 1] = m_heap.pop();
+
+        return result;
+    }
+
+    void clear() {
+        m_heap.clear();
+    }
+};
+
+// Partial sort of a stream: the k greatest elements of [first, last), greatest first.
+template<typename Compare = std::less<>, typename InputIt>
+[[nodiscard]] auto top_k(InputIt first, InputIt last, const std::size_t k) {
+    TopK<std::decay_t<decltype(*first)>, Compare> top(k);
+    top.push_all(first, last);
+    return top.into_sorted_vec();
+}
+
+#endif
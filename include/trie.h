@@ -1,28 +1,53 @@
 #ifndef STRUCTZ_TRIE_H
 #define STRUCTZ_TRIE_H
 
-#include <array>
 #include <cstddef>
+#include <optional>
 #include <string_view>
+#include <variant>
+#include "binary_io.h"
+#include "frozen_trie_map.h"
+#include "trie_map.h"
+
+using FrozenTrie = FrozenTrieMap<std::monostate>;
 
 class Trie {
-    struct Node {
-        static constexpr std::size_t SIZE = 'z' - 'a' + 1;
+    TrieMap<std::monostate> map;
+
+public:
+    using const_iterator = TrieMap<std::monostate>::const_iterator;
+    using const_range = TrieMap<std::monostate>::const_range;
 
-        std::array<Node*, SIZE> children{nullptr};
-        bool is_end = false;
-    };
+    [[nodiscard]] std::size_t size() const;
 
-    Node* root = nullptr;
+    [[nodiscard]] bool is_empty() const;
 
-    static std::size_t idx(char ch);
+    bool insert(std::string_view word);
 
-public:
-    void insert(std::string_view word);
+    bool remove(std::string_view word);
 
     [[nodiscard]] bool contains(std::string_view word) const;
 
     [[nodiscard]] bool has_prefix(std::string_view prefix) const;
+
+    // Length of the longest inserted word that is a prefix of `text`.
+    [[nodiscard]] std::optional<std::size_t> longest_prefix(std::string_view text) const;
+
+    [[nodiscard]] const_range find_prefix(std::string_view prefix) const;
+
+    void compact();
+
+    [[nodiscard]] FrozenTrie freeze() const;
+
+    void clear();
+
+    void serialize(BinaryWriter& writer) const;
+
+    static Trie deserialize(BinaryReader& reader);
+
+    [[nodiscard]] const_iterator begin() const;
+
+    [[nodiscard]] const_iterator end() const;
 };
 
 #endif
@@ -0,0 +1,640 @@
+#ifndef STRUCTZ_TRIE_MAP_H
+#define STRUCTZ_TRIE_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "binary_io.h"
+#include "frozen_trie_map.h"
+#include "vec.h"
+
+// Map from arbitrary byte strings to values, stored as a path-compressed (radix) trie. Every node
+// owns the whole unbranched run of bytes leading to it, so long suffixes cost one node.
+template<typename T>
+class TrieMap {
+    struct Node {
+        std::string label;
+        Vec<Node*> children;  // Sorted by the first byte of their labels, as unsigned char.
+        std::optional<T> value;
+    };
+
+    Node* m_root = nullptr;
+    std::size_t m_size = 0;
+
+    // Nodes laid out breadth-first by compact(). Nodes created afterwards are allocated
+    // individually; slab nodes are never deleted one by one, only with the whole slab.
+    Vec<Node> m_slab;
+
+    [[nodiscard]] bool in_slab(const Node* const node) const {
+        const std::less<const Node*> before;
+        return !before(node, m_slab.begin()) && before(node, m_slab.end());
+    }
+
+    void release(Node* const node) const {
+        if (!in_slab(node))
+            delete node;
+    }
+
+    // Folds the only child of `node` into it, so no valueless node has a single child.
+    void absorb_only_child(Node* const node) {
+        Node* const child = node->children.first();
+
+        node->label += child->label;
+        node->value = std::move(child->value);
+        node->children = std::move(child->children);
+
+        release(child);
+    }
+
+    [[nodiscard]] static unsigned char byte(const char ch) {
+        return static_cast<unsigned char>(ch);
+    }
+
+    [[nodiscard]] static std::size_t child_index(const Node* const node, const char first) {
+        const auto it = std::lower_bound(node->children.begin(), node->children.end(), first,
+                                         [](const Node* const child, const char ch) {
+                                             return byte(child->label.front()) < byte(ch);
+                                         });
+
+        return it - node->children.begin();
+    }
+
+    [[nodiscard]] static Node* find_child(const Node* const node, const char first) {
+        const std::size_t i = child_index(node, first);
+
+        if (i < node->children.size() && node->children[i]->label.front() == first)
+            return node->children[i];
+
+        return nullptr;
+    }
+
+    [[nodiscard]] static std::size_t common_prefix(const std::string_view a,
+                                                   const std::string_view b) {
+        return std::mismatch(a.begin(), a.end(), b.begin(), b.end()).first - a.begin();
+    }
+
+    // The node whose path spells exactly `key`, if any.
+    [[nodiscard]] Node* find_node(const std::string_view key) const {
+        if (m_root == nullptr)
+            return nullptr;
+
+        Node* cur = m_root;
+        std::string_view rest = key;
+
+        while (!rest.empty()) {
+            cur = find_child(cur, rest.front());
+
+            if (cur == nullptr || rest.substr(0, cur->label.size()) != cur->label)
+                return nullptr;
+
+            rest.remove_prefix(cur->label.size());
+        }
+
+        return cur;
+    }
+
+    // The shallowest node whose path starts with `prefix`. Its full path is written to `path`.
+    [[nodiscard]] Node* find_prefix_node(const std::string_view prefix, std::string& path) const {
+        if (m_root == nullptr)
+            return nullptr;
+
+        Node* cur = m_root;
+        std::string_view rest = prefix;
+
+        while (!rest.empty()) {
+            cur = find_child(cur, rest.front());
+
+            if (cur == nullptr)
+                return nullptr;
+
+            if (rest.size() <= cur->label.size()) {
+                if (cur->label.compare(0, rest.size(), rest) != 0)
+                    return nullptr;
+
+                path += cur->label;
+                return cur;
+            }
+
+            if (rest.substr(0, cur->label.size()) != cur->label)
+                return nullptr;
+
+            path += cur->label;
+            rest.remove_prefix(cur->label.size());
+        }
+
+        return cur;
+    }
+
+    // The deepest node with a value whose path is a prefix of `text`. Its depth goes to `length`.
+    [[nodiscard]] Node* longest_prefix_node(const std::string_view text,
+                                            std::size_t& length) const {
+        if (m_root == nullptr)
+            return nullptr;
+
+        Node* cur = m_root;
+        Node* best = cur->value.has_value() ? cur : nullptr;
+        std::size_t depth = 0;
+        length = 0;
+
+        while (depth < text.size()) {
+            cur = find_child(cur, text[depth]);
+
+            if (cur == nullptr || text.substr(depth, cur->label.size()) != cur->label)
+                break;
+
+            depth += cur->label.size();
+
+            if (cur->value.has_value()) {
+                best = cur;
+                length = depth;
+            }
+        }
+
+        return best;
+    }
+
+    void swap(TrieMap& other) noexcept {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+        std::swap(m_slab, other.m_slab);
+    }
+
+    // Pre-order walk over the subtree of a node, which visits keys in byte-wise lexicographic
+    // order. Only the path from the subtree root to the current node is kept.
+    template<bool IsConst>
+    class basic_iterator {
+        using node_type = std::conditional_t<IsConst, const Node, Node>;
+        using mapped_type = std::conditional_t<IsConst, const T, T>;
+
+        struct Frame {
+            node_type* node = nullptr;
+            std::size_t next_child = 0;
+        };
+
+        Vec<Frame> stack;
+        std::string m_key;
+
+        friend class TrieMap;
+
+        basic_iterator(node_type* const start, std::string key)
+            : m_key(std::move(key)) {
+            if (start == nullptr)
+                return;
+
+            stack.push({start, 0});
+
+            if (!start->value.has_value())
+                advance();
+        }
+
+        void advance() {
+            while (!stack.is_empty()) {
+                Frame& top = stack.last();
+
+                if (top.next_child < top.node->children.size()) {
+                    node_type* const child = top.node->children[top.next_child++];
+                    m_key += child->label;
+                    stack.push({child, 0});
+
+                    if (child->value.has_value())
+                        return;
+                } else {
+                    m_key.resize(m_key.size() - top.node->label.size());
+                    stack.pop();
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const std::string&, mapped_type&>;
+        using reference = value_type;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+
+        basic_iterator() = default;
+
+        basic_iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            if (stack.is_empty() || other.stack.is_empty())
+                return stack.is_empty() && other.stack.is_empty();
+
+            return stack.last().node == other.stack.last().node;
+        }
+
+        bool operator!=(const basic_iterator& other) const {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] const std::string& key() const {
+            return m_key;
+        }
+
+        [[nodiscard]] mapped_type& value() const {
+            return *stack.last().node->value;
+        }
+
+        value_type operator*() const {
+            return {key(), value()};
+        }
+    };
+
+    template<bool IsConst>
+    class basic_range {
+        basic_iterator<IsConst> m_begin;
+
+    public:
+        explicit basic_range(basic_iterator<IsConst> begin)
+            : m_begin(std::move(begin)) {}
+
+        [[nodiscard]] basic_iterator<IsConst> begin() const {
+            return m_begin;
+        }
+
+        [[nodiscard]] basic_iterator<IsConst> end() const {
+            return {};
+        }
+
+        [[nodiscard]] bool is_empty() const {
+            return m_begin == end();
+        }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using range = basic_range<false>;
+    using const_range = basic_range<true>;
+
+    TrieMap() = default;
+
+    TrieMap(const TrieMap& other)
+        : m_size(other.m_size) {
+        Vec<std::pair<Node**, const Node*>> stack;
+        stack.push({&m_root, other.m_root});
+
+        while (!stack.is_empty()) {
+            const auto [dest, src] = stack.pop();
+            if (src == nullptr)
+                continue;
+
+            *dest = new Node{src->label, Vec<Node*>(src->children.size()), src->value};
+
+            for (std::size_t i = 0; i < src->children.size(); ++i)
+                stack.push({&(*dest)->children[i], src->children[i]});
+        }
+    }
+
+    TrieMap(TrieMap&& other) noexcept {
+        swap(other);
+    }
+
+    ~TrieMap() {
+        Vec<Node*> stack;
+        stack.push(std::exchange(m_root, nullptr));
+
+        while (!stack.is_empty()) {
+            Node* const node = stack.pop();
+            if (node == nullptr)
+                continue;
+
+            for (Node* const child : node->children)
+                stack.push(child);
+
+            release(node);
+        }
+
+        m_size = 0;
+    }
+
+    TrieMap& operator=(const TrieMap& other) {
+        TrieMap(other).swap(*this);
+        return *this;
+    }
+
+    TrieMap& operator=(TrieMap&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    bool insert(const std::string_view key, T value) {
+        if (m_root == nullptr)
+            m_root = new Node();
+
+        Node* cur = m_root;
+        std::string_view rest = key;
+
+        while (!rest.empty()) {
+            const std::size_t i = child_index(cur, rest.front());
+
+            if (i == cur->children.size() || cur->children[i]->label.front() != rest.front()) {
+                Node* const leaf = new Node{std::string(rest), {}, std::move(value)};
+
+                cur->children.push(leaf);
+                std::rotate(cur->children.begin() + i, cur->children.end() - 1,
+                            cur->children.end());
+
+                ++m_size;
+                return true;
+            }
+
+            Node* child = cur->children[i];
+            const std::size_t common = common_prefix(child->label, rest);
+
+            if (common < child->label.size()) {
+                // Split the edge: the shared part becomes a new node above the old child.
+                Node* const mid = new Node{child->label.substr(0, common), {}, std::nullopt};
+                child->label.erase(0, common);
+                mid->children.push(child);
+
+                cur->children[i] = mid;
+                child = mid;
+            }
+
+            rest.remove_prefix(common);
+            cur = child;
+        }
+
+        if (cur->value.has_value()) {
+            *cur->value = std::move(value);
+            return false;
+        }
+
+        cur->value = std::move(value);
+        ++m_size;
+        return true;
+    }
+
+    [[nodiscard]] bool contains(const std::string_view key) const {
+        const Node* const node = find_node(key);
+        return node != nullptr && node->value.has_value();
+    }
+
+    [[nodiscard]] T* find(const std::string_view key) {
+        Node* const node = find_node(key);
+        return node != nullptr && node->value.has_value() ? &*node->value : nullptr;
+    }
+
+    [[nodiscard]] const T* find(const std::string_view key) const {
+        const Node* const node = find_node(key);
+        return node != nullptr && node->value.has_value() ? &*node->value : nullptr;
+    }
+
+    [[nodiscard]] T& get(const std::string_view key) {
+        if (T* const value = find(key))
+            return *value;
+
+        throw std::out_of_range("Key not found");
+    }
+
+    [[nodiscard]] const T& get(const std::string_view key) const {
+        if (const T* const value = find(key))
+            return *value;
+
+        throw std::out_of_range("Key not found");
+    }
+
+    [[nodiscard]] bool has_prefix(const std::string_view prefix) const {
+        return !find_prefix(prefix).is_empty();
+    }
+
+    // The longest key that is a prefix of `text`, as its length and a pointer to its value.
+    [[nodiscard]] std::optional<std::pair<std::size_t, T*>> longest_prefix(
+        const std::string_view text) {
+        std::size_t length = 0;
+        Node* const node = longest_prefix_node(text, length);
+
+        if (node == nullptr)
+            return std::nullopt;
+
+        return std::pair{length, &*node->value};
+    }
+
+    [[nodiscard]] std::optional<std::pair<std::size_t, const T*>> longest_prefix(
+        const std::string_view text) const {
+        std::size_t length = 0;
+        const Node* const node = longest_prefix_node(text, length);
+
+        if (node == nullptr)
+            return std::nullopt;
+
+        return std::pair<std::size_t, const T*>{length, &*node->value};
+    }
+
+    // Lazily enumerates all entries whose key starts with `prefix`, in lexicographic order.
+    [[nodiscard]] range find_prefix(const std::string_view prefix) {
+        std::string path;
+        Node* const start = find_prefix_node(prefix, path);
+        return range(iterator(start, std::move(path)));
+    }
+
+    [[nodiscard]] const_range find_prefix(const std::string_view prefix) const {
+        std::string path;
+        const Node* const start = find_prefix_node(prefix, path);
+        return const_range(const_iterator(start, std::move(path)));
+    }
+
+    bool remove(const std::string_view key) {
+        if (m_root == nullptr)
+            return false;
+
+        Node* parent = nullptr;
+        std::size_t index = 0;
+        Node* cur = m_root;
+        std::string_view rest = key;
+
+        while (!rest.empty()) {
+            parent = cur;
+            index = child_index(cur, rest.front());
+
+            if (index == cur->children.size())
+                return false;
+
+            cur = cur->children[index];
+
+            if (rest.substr(0, cur->label.size()) != cur->label)
+                return false;
+
+            rest.remove_prefix(cur->label.size());
+        }
+
+        if (!cur->value.has_value())
+            return false;
+
+        cur->value.reset();
+        --m_size;
+
+        if (parent == nullptr)
+            return true;
+
+        // Prune the emptied node, then re-compress whatever now has a single child.
+        if (cur->children.is_empty()) {
+            std::rotate(parent->children.begin() + index, parent->children.begin() + index + 1,
+                        parent->children.end());
+            parent->children.pop();
+            release(cur);
+
+            if (parent != m_root && !parent->value.has_value() && parent->children.size() == 1)
+                absorb_only_child(parent);
+        } else if (cur->children.size() == 1) {
+            absorb_only_child(cur);
+        }
+
+        return true;
+    }
+
+    // Moves every node into one contiguous slab in breadth-first order, so siblings and the
+    // upper levels are adjacent in memory. The old nodes (and any previous slab) are freed.
+    void compact() {
+        if (m_root == nullptr)
+            return;
+
+        Vec<Node*> order;
+        order.push(m_root);
+
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (Node* const child : order[i]->children)
+                order.push(child);
+        }
+
+        Vec<Node> slab(order.size());
+        std::size_t next = 1;
+
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            Node* const old = order[i];
+            Node& node = slab[i];
+
+            node.label = std::move(old->label);
+            node.value = std::move(old->value);
+            node.children = Vec<Node*>(old->children.size());
+
+            // Breadth-first order means the children of node i are the next ones enqueued.
+            for (std::size_t j = 0; j < old->children.size(); ++j)
+                node.children[j] = &slab[next++];
+        }
+
+        for (Node* const old : order)
+            release(old);
+
+        m_slab = std::move(slab);
+        m_root = &m_slab.first();
+    }
+
+    // Builds an immutable LOUDS snapshot; the trie itself is left untouched.
+    [[nodiscard]] FrozenTrieMap<T> freeze() const {
+        FrozenTrieMap<T> frozen;
+
+        if (m_root == nullptr) {
+            frozen.m_louds.build_index();
+            frozen.m_terminal.build_index();
+            frozen.m_label_starts.build_index();
+            return frozen;
+        }
+
+        Vec<const Node*> order;
+        order.push(m_root);
+
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const Node* const node = order[i];
+
+            for (const Node* const child : node->children) {
+                order.push(child);
+                frozen.m_louds.push(true);
+            }
+
+            frozen.m_louds.push(false);
+            frozen.m_terminal.push(node->value.has_value());
+
+            if (node->value.has_value())
+                frozen.m_values.push(*node->value);
+
+            if (node != m_root) {
+                frozen.m_labels += node->label;
+                frozen.m_first_bytes += node->label.front();
+
+                frozen.m_label_starts.push(true);
+                for (std::size_t j = 1; j < node->label.size(); ++j)
+                    frozen.m_label_starts.push(false);
+            }
+        }
+
+        frozen.m_label_starts.push(true);
+        frozen.m_node_count = order.size();
+
+        frozen.m_louds.build_index();
+        frozen.m_terminal.build_index();
+        frozen.m_label_starts.build_index();
+
+        return frozen;
+    }
+
+    void clear() {
+        TrieMap().swap(*this);
+    }
+
+    // Stores the entries in key order, each as its full key followed by its value.
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        for (auto it = begin(); it != end(); ++it) {
+            writer.write(it.key());
+            writer.write(it.value());
+        }
+    }
+
+    // Inserting in key order only ever appends to the rightmost path; the result is compacted.
+    static TrieMap deserialize(BinaryReader& reader) {
+        TrieMap map;
+
+        for (std::size_t i = reader.read_count<std::pair<std::string, T>>(); i > 0; --i) {
+            const std::string key = reader.read<std::string>();
+            map.insert(key, reader.read<T>());
+        }
+
+        map.compact();
+        return map;
+    }
+
+    [[nodiscard]] iterator begin() {
+        return iterator(m_root, "");
+    }
+
+    [[nodiscard]] iterator end() {
+        return iterator();
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(m_root, "");
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator();
+    }
+};
+
+#endif
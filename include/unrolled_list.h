@@ -0,0 +1,449 @@
+#ifndef STRUCTZ_UNROLLED_LIST_H
+#define STRUCTZ_UNROLLED_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "binary_io.h"
+
+// Doubly linked list of chunks, each holding up to ChunkSize elements in a contiguous slice of
+// slots. Iteration walks arrays instead of chasing a pointer per element, and the link overhead
+// is shared by a whole chunk.
+//
+// Pushes and pops never move elements: push_back() fills the tail chunk forwards and push_front()
+// fills the head chunk backwards, opening a new chunk when the slots on that side run out. So
+// pushes and pops at either end are O(1) and keep every iterator and reference valid, except
+// those to popped elements. remove() shifts the rest of its chunk, and merges the chunk with a
+// neighbour once it is less than half full, so it invalidates iterators into both.
+template<typename T, std::size_t ChunkSize = sizeof(T) <= 16 ? 64 : 32>
+class UnrolledList {
+    static_assert(ChunkSize > 0, "chunks must hold at least one element");
+
+    struct Chunk {
+        Chunk* prev = nullptr;
+        Chunk* next = nullptr;
+        // The elements occupy slots [begin, end); a chunk in the list is never empty.
+        std::size_t begin;
+        std::size_t end;
+        alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+
+        // An empty chunk whose first element will go in slot `at`.
+        explicit Chunk(const std::size_t at)
+            : begin(at),
+              end(at) {}
+
+        [[nodiscard]] T* slot(const std::size_t index) {
+            return std::launder(reinterpret_cast<T*>(storage)) + index;
+        }
+
+        [[nodiscard]] const T* slot(const std::size_t index) const {
+            return std::launder(reinterpret_cast<const T*>(storage)) + index;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return end - begin;
+        }
+    };
+
+    // A position is a chunk and a slot in it. The end of a non-empty list is one past the last
+    // slot used in the tail chunk, so that it can be decremented.
+    //
+    // The iterator caches where its chunk's elements ended when it last looked, so stepping
+    // inside a chunk is a pointer increment and compare. The chunk is only consulted again at
+    // that point, in case push_back() added elements since.
+    template<bool IsConst>
+    class basic_iterator {
+        using chunk_pointer = std::conditional_t<IsConst, const Chunk*, Chunk*>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+        chunk_pointer m_chunk = nullptr;
+        pointer m_cur = nullptr;
+        pointer m_limit = nullptr;
+
+        void next_chunk() {
+            m_limit = m_chunk->slot(m_chunk->end);
+
+            if (m_cur == m_limit && m_chunk->next != nullptr) {
+                m_chunk = m_chunk->next;
+                m_cur = m_chunk->slot(m_chunk->begin);
+                m_limit = m_chunk->slot(m_chunk->end);
+            }
+        }
+
+    public:
+        basic_iterator() = default;
+
+        basic_iterator(const chunk_pointer chunk, const std::size_t index)
+            : m_chunk(chunk),
+              m_cur(chunk->slot(index)),
+              m_limit(chunk->slot(chunk->end)) {}
+
+        reference operator*() const {
+            return *m_cur;
+        }
+
+        pointer operator->() const {
+            return m_cur;
+        }
+
+        basic_iterator& operator++() {
+            if (++m_cur == m_limit)
+                next_chunk();
+
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+
+        basic_iterator& operator--() {
+            if (m_cur == m_chunk->slot(m_chunk->begin)) {
+                m_chunk = m_chunk->prev;
+                m_cur = m_chunk->slot(m_chunk->end);
+                m_limit = m_cur;
+            }
+
+            --m_cur;
+            return *this;
+        }
+
+        basic_iterator operator--(int) {
+            basic_iterator retval = *this;
+            --(*this);
+            return retval;
+        }
+
+        // Slots are only compared within a chunk, since end() may point one past the storage of
+        // a full tail chunk.
+        bool operator==(const basic_iterator& other) const {
+            return m_chunk == other.m_chunk && m_cur == other.m_cur;
+        }
+
+        bool operator!=(const basic_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    Chunk* m_head = nullptr;
+    Chunk* m_tail = nullptr;
+    std::size_t m_size = 0;
+
+    void swap(UnrolledList& other) noexcept {
+        std::swap(m_head, other.m_head);
+        std::swap(m_tail, other.m_tail);
+        std::swap(m_size, other.m_size);
+    }
+
+    // Unlinks and frees a chunk that has become empty.
+    void drop(Chunk* const chunk) {
+        (chunk->prev != nullptr ? chunk->prev->next : m_head) = chunk->next;
+        (chunk->next != nullptr ? chunk->next->prev : m_tail) = chunk->prev;
+        delete chunk;
+    }
+
+    // Moves the elements of the chunk after `chunk` to its end and frees that chunk. Both must fit
+    // in one.
+    void merge_with_next(Chunk* const chunk) {
+        Chunk* const next = chunk->next;
+
+        if (chunk->end + next->size() > ChunkSize) {
+            for (std::size_t i = chunk->begin; i < chunk->end; ++i) {
+                new (chunk->slot(i - chunk->begin)) T(std::move(*chunk->slot(i)));
+                chunk->slot(i)->~T();
+            }
+
+            chunk->end -= chunk->begin;
+            chunk->begin = 0;
+        }
+
+        for (std::size_t i = next->begin; i < next->end; ++i) {
+            new (chunk->slot(chunk->end++)) T(std::move(*next->slot(i)));
+            next->slot(i)->~T();
+        }
+
+        drop(next);
+    }
+
+    template<typename Self>
+    static auto& at(Self& self, std::size_t index) {
+        if (index >= self.m_size)
+            throw std::out_of_range("list index out of bounds");
+
+        auto chunk = self.m_head;
+
+        while (index >= chunk->size()) {
+            index -= chunk->size();
+            chunk = chunk->next;
+        }
+
+        return *chunk->slot(chunk->begin + index);
+    }
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    UnrolledList() = default;
+
+    UnrolledList(const UnrolledList& other) {
+        for (const auto& el : other)
+            push_back(el);
+    }
+
+    UnrolledList(UnrolledList&& other) noexcept {
+        swap(other);
+    }
+
+    ~UnrolledList() {
+        clear();
+    }
+
+    UnrolledList& operator=(const UnrolledList& other) {
+        UnrolledList(other).swap(*this);
+        return *this;
+    }
+
+    UnrolledList& operator=(UnrolledList&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    [[nodiscard]] T& front() {
+        if (m_head == nullptr)
+            throw std::runtime_error("list is empty");
+
+        return *m_head->slot(m_head->begin);
+    }
+
+    [[nodiscard]] const T& front() const {
+        if (m_head == nullptr)
+            throw std::runtime_error("list is empty");
+
+        return *m_head->slot(m_head->begin);
+    }
+
+    [[nodiscard]] T& back() {
+        if (m_tail == nullptr)
+            throw std::runtime_error("list is empty");
+
+        return *m_tail->slot(m_tail->end - 1);
+    }
+
+    [[nodiscard]] const T& back() const {
+        if (m_tail == nullptr)
+            throw std::runtime_error("list is empty");
+
+        return *m_tail->slot(m_tail->end - 1);
+    }
+
+    void push_front(T data) {
+        if (m_head == nullptr || m_head->begin == 0) {
+            auto* const chunk = new Chunk(ChunkSize);
+            chunk->next = m_head;
+
+            (m_head != nullptr ? m_head->prev : m_tail) = chunk;
+            m_head = chunk;
+        }
+
+        new (m_head->slot(m_head->begin - 1)) T(std::move(data));
+        --m_head->begin;
+        ++m_size;
+    }
+
+    void push_back(T data) {
+        if (m_tail == nullptr || m_tail->end == ChunkSize) {
+            auto* const chunk = new Chunk(0);
+            chunk->prev = m_tail;
+
+            (m_tail != nullptr ? m_tail->next : m_head) = chunk;
+            m_tail = chunk;
+        }
+
+        new (m_tail->slot(m_tail->end)) T(std::move(data));
+        ++m_tail->end;
+        ++m_size;
+    }
+
+    T pop_front() {
+        if (m_head == nullptr)
+            throw std::runtime_error("list is empty");
+
+        T* const slot = m_head->slot(m_head->begin);
+        T data = std::move(*slot);
+        slot->~T();
+
+        if (++m_head->begin == m_head->end)
+            drop(m_head);
+
+        --m_size;
+        return data;
+    }
+
+    T pop_back() {
+        if (m_tail == nullptr)
+            throw std::runtime_error("list is empty");
+
+        T* const slot = m_tail->slot(m_tail->end - 1);
+        T data = std::move(*slot);
+        slot->~T();
+
+        if (--m_tail->end == m_tail->begin)
+            drop(m_tail);
+
+        --m_size;
+        return data;
+    }
+
+    void remove(std::size_t index) {
+        if (index >= m_size)
+            throw std::out_of_range("list index out of bounds");
+
+        Chunk* chunk = m_head;
+
+        while (index >= chunk->size()) {
+            index -= chunk->size();
+            chunk = chunk->next;
+        }
+
+        T* const first = chunk->slot(chunk->begin + index);
+        T* const last = chunk->slot(chunk->end);
+
+        std::move(first + 1, last, first);
+        (last - 1)->~T();
+
+        --m_size;
+
+        if (--chunk->end == chunk->begin) {
+            drop(chunk);
+            return;
+        }
+
+        if (chunk->size() >= ChunkSize / 2)
+            return;
+
+        if (chunk->next != nullptr && chunk->size() + chunk->next->size() <= ChunkSize)
+            merge_with_next(chunk);
+        else if (chunk->prev != nullptr && chunk->prev->size() + chunk->size() <= ChunkSize)
+            merge_with_next(chunk->prev);
+    }
+
+    [[nodiscard]] const T& operator[](const std::size_t index) const {
+        return at(*this, index);
+    }
+
+    [[nodiscard]] T& operator[](const std::size_t index) {
+        return at(*this, index);
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        return m_size;
+    }
+
+    // Number of chunks allocated, in O(number of chunks).
+    [[nodiscard]] std::size_t chunk_count() const {
+        std::size_t count = 0;
+
+        for (const Chunk* chunk = m_head; chunk != nullptr; chunk = chunk->next)
+            ++count;
+
+        return count;
+    }
+
+    void clear() {
+        Chunk* chunk = std::exchange(m_head, nullptr);
+
+        while (chunk != nullptr) {
+            for (std::size_t i = chunk->begin; i < chunk->end; ++i)
+                chunk->slot(i)->~T();
+
+            delete std::exchange(chunk, chunk->next);
+        }
+
+        m_tail = nullptr;
+        m_size = 0;
+    }
+
+    // Reverses each chunk in place and the order of the chunks.
+    void reverse() {
+        for (Chunk* chunk = m_head; chunk != nullptr; chunk = chunk->prev) {
+            std::reverse(chunk->slot(chunk->begin), chunk->slot(chunk->end));
+            std::swap(chunk->prev, chunk->next);
+        }
+
+        std::swap(m_head, m_tail);
+    }
+
+    // Calls `f` on every element in order, one chunk at a time. The loop over a chunk runs over
+    // a plain array, so the compiler can unroll and vectorize it like a loop over a Vec.
+    template<typename F>
+    void for_each(F&& f) {
+        for (Chunk* chunk = m_head; chunk != nullptr; chunk = chunk->next) {
+            T* const last = chunk->slot(chunk->end);
+
+            for (T* el = chunk->slot(chunk->begin); el != last; ++el)
+                f(*el);
+        }
+    }
+
+    template<typename F>
+    void for_each(F&& f) const {
+        for (const Chunk* chunk = m_head; chunk != nullptr; chunk = chunk->next) {
+            const T* const last = chunk->slot(chunk->end);
+
+            for (const T* el = chunk->slot(chunk->begin); el != last; ++el)
+                f(*el);
+        }
+    }
+
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+
+        for (const T& el : *this)
+            writer.write(el);
+    }
+
+    static UnrolledList deserialize(BinaryReader& reader) {
+        UnrolledList list;
+
+        for (std::size_t i = reader.read_count<T>(); i > 0; --i)
+            list.push_back(reader.read<T>());
+
+        return list;
+    }
+
+    [[nodiscard]] iterator begin() {
+        return m_head == nullptr ? iterator() : iterator(m_head, m_head->begin);
+    }
+
+    [[nodiscard]] iterator end() {
+        return m_tail == nullptr ? iterator() : iterator(m_tail, m_tail->end);
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return m_head == nullptr ? const_iterator() : const_iterator(m_head, m_head->begin);
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return m_tail == nullptr ? const_iterator() : const_iterator(m_tail, m_tail->end);
+    }
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <utility>
+#include "binary_io.h"
 
 template<typename T>
 class Vec {
@@ -145,6 +146,19 @@ public:
         return m_data[m_size - 1];
     }
 
+    void reserve(const std::size_t new_capacity) {
+        if (new_capacity <= m_capacity)
+            return;
+
+        T* const new_data = new T[new_capacity]();
+
+        std::move(m_data, &m_data[m_size], new_data);
+
+        delete[] std::exchange(m_data, new_data);
+
+        m_capacity = new_capacity;
+    }
+
     void push(T value) {
         if (m_size == m_capacity) {
             const std::size_t new_capacity = m_capacity == 0 ? 4 : 2 * m_capacity;
@@ -175,6 +189,22 @@ public:
         Vec<T>().swap(*this);
     }
 
+    // Trivially copyable elements are stored as one aligned block, which MappedVec can map in
+    // place and deserialize() reads straight into the new buffer.
+    void serialize(BinaryWriter& writer) const {
+        writer.write_size(m_size);
+        writer.write_array(m_data, m_size);
+    }
+
+    static Vec<T> deserialize(BinaryReader& reader) {
+        Vec<T> vec = with_capacity(reader.read_count<T>());
+
+        reader.read_array(vec.m_data, vec.m_capacity);
+        vec.m_size = vec.m_capacity;
+
+        return vec;
+    }
+
     [[nodiscard]] constexpr iterator begin() {
         return m_data;
     }
@@ -0,0 +1,126 @@
+#include "aho_corasick.h"
+#include "queue.h"
+#include "trie.h"
+#include "vec.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+AhoCorasick::AhoCorasick(const Trie& patterns) {
+    std::size_t total_bytes = 0;
+
+    for (const auto& [word, _] : patterns) {
+        if (word.empty())
+            continue;
+
+        m_patterns.push(word);
+        total_bytes += word.size();
+
+        for (const char ch : word) {
+            std::uint16_t& cls = m_classes[static_cast<unsigned char>(ch)];
+
+            if (cls == 0)
+                cls = static_cast<std::uint16_t>(m_class_count++);
+        }
+    }
+
+    // Goto trie over byte classes; missing edges are NONE until the failure pass fills them.
+    m_delta.reserve((total_bytes + 1) * m_class_count);
+
+    const auto add_state = [this]() {
+        for (std::size_t c = 0; c < m_class_count; ++c)
+            m_delta.push(NONE);
+
+        m_output.push(NONE);
+        return static_cast<State>(m_output.size() - 1);
+    };
+
+    add_state();
+
+    for (std::size_t id = 0; id < m_patterns.size(); ++id) {
+        State state = 0;
+
+        for (const char ch : m_patterns[id]) {
+            const std::size_t slot =
+                (state * m_class_count) + m_classes[static_cast<unsigned char>(ch)];
+
+            if (m_delta[slot] == NONE) {
+                const State created = add_state();
+                m_delta[slot] = created;
+            }
+
+            state = m_delta[slot];
+        }
+
+        m_output[state] = static_cast<State>(id);
+    }
+
+    // Breadth-first: a state's failure target is shallower, so its row is already complete.
+    Vec<State> fail(m_output.size());
+    m_first_report = Vec<State>(m_output.size());
+    m_next_report = Vec<State>(m_output.size());
+
+    m_first_report[0] = NONE;
+    m_next_report[0] = NONE;
+
+    Queue<State> queue;
+    queue.enqueue(0);
+
+    while (!queue.is_empty()) {
+        const State state = queue.dequeue();
+
+        for (std::size_t c = 0; c < m_class_count; ++c) {
+            State& target = m_delta[(state * m_class_count) + c];
+            const State fallback = state == 0 ? 0 : m_delta[(fail[state] * m_class_count) + c];
+
+            if (target == NONE) {
+                target = fallback;
+                continue;
+            }
+
+            fail[target] = fallback;
+
+            const State link = fallback == 0 ? NONE : m_first_report[fallback];
+            m_next_report[target] = link;
+            m_first_report[target] = m_output[target] != NONE ? target : link;
+
+            queue.enqueue(target);
+        }
+    }
+}
+
+std::size_t AhoCorasick::pattern_count() const {
+    return m_patterns.size();
+}
+
+const std::string& AhoCorasick::pattern(const std::size_t id) const {
+    if (id >= m_patterns.size())
+        throw std::out_of_range("Pattern id out of bounds");
+
+    return m_patterns[id];
+}
+
+std::size_t AhoCorasick::state_count() const {
+    return m_output.size();
+}
+
+Vec<AhoCorasick::Match> AhoCorasick::find_all(const std::string_view text) const {
+    Vec<Match> matches;
+    for_each_match(text, [&matches](const Match& match) { matches.push(match); });
+    return matches;
+}
+
+bool AhoCorasick::contains_any(const std::string_view text) const {
+    State state = 0;
+
+    for (const char ch : text) {
+        state = next(state, ch);
+
+        if (m_first_report[state] != NONE)
+            return true;
+    }
+
+    return false;
+}
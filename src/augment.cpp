@@ -0,0 +1 @@
+#include "augment.h"
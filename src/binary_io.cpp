@@ -0,0 +1,124 @@
+#include "binary_io.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+    constexpr std::array<char, 8> MAGIC = {'S', 'T', 'Z', 'S', 'N', 'A', 'P', '\0'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    std::size_t padding(const std::uint64_t position, const std::size_t alignment) {
+        return (alignment - position % alignment) % alignment;
+    }
+}
+
+BinaryWriter::BinaryWriter(std::ostream& out)
+    : m_out(out) {}
+
+std::uint64_t BinaryWriter::position() const {
+    return m_position;
+}
+
+void BinaryWriter::write_bytes(const void* const data, const std::size_t size) {
+    m_out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+
+    if (!m_out)
+        throw std::runtime_error("Failed to write snapshot");
+
+    m_position += size;
+}
+
+void BinaryWriter::write_size(const std::size_t size) {
+    const auto value = static_cast<std::uint64_t>(size);
+    write_bytes(&value, sizeof(value));
+}
+
+void BinaryWriter::align(const std::size_t alignment) {
+    static constexpr std::array<char, 64> zeros{};
+
+    for (std::size_t rest = padding(m_position, alignment); rest > 0;) {
+        const std::size_t chunk = rest < zeros.size() ? rest : zeros.size();
+        write_bytes(zeros.data(), chunk);
+        rest -= chunk;
+    }
+}
+
+void BinaryWriter::write_header() {
+    write_bytes(MAGIC.data(), MAGIC.size());
+    write_bytes(&VERSION, sizeof(VERSION));
+    write_bytes(&BYTE_ORDER_MARK, sizeof(BYTE_ORDER_MARK));
+}
+
+BinaryReader::BinaryReader(std::istream& in)
+    : m_in(in),
+      m_available(std::numeric_limits<std::uint64_t>::max()) {
+    const std::istream::pos_type start = m_in.tellg();
+    if (start == std::istream::pos_type(-1))
+        return;
+
+    m_in.seekg(0, std::ios::end);
+    const std::istream::pos_type end = m_in.tellg();
+    m_in.clear();
+    m_in.seekg(start);
+
+    if (end != std::istream::pos_type(-1))
+        m_available = static_cast<std::uint64_t>(end - start);
+}
+
+void BinaryReader::check_header(const std::byte* const data, const std::size_t size) {
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC.data(), MAGIC.size()) != 0)
+        throw std::runtime_error("Not a snapshot");
+
+    std::uint32_t version = 0;
+    std::uint32_t byte_order_mark = 0;
+    std::memcpy(&version, data + MAGIC.size(), sizeof(version));
+    std::memcpy(&byte_order_mark, data + MAGIC.size() + sizeof(version), sizeof(byte_order_mark));
+
+    if (version != VERSION)
+        throw std::runtime_error("Unsupported snapshot version");
+
+    if (byte_order_mark != BYTE_ORDER_MARK)
+        throw std::runtime_error("Snapshot was written with a different byte order");
+}
+
+std::uint64_t BinaryReader::position() const {
+    return m_position;
+}
+
+void BinaryReader::read_bytes(void* const data, const std::size_t size) {
+    m_in.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+
+    if (static_cast<std::size_t>(m_in.gcount()) != size)
+        throw std::runtime_error("Unexpected end of snapshot");
+
+    m_position += size;
+}
+
+std::size_t BinaryReader::read_size() {
+    std::uint64_t value = 0;
+    read_bytes(&value, sizeof(value));
+    return static_cast<std::size_t>(value);
+}
+
+void BinaryReader::align(const std::size_t alignment) {
+    std::array<char, 64> skipped{};
+
+    for (std::size_t rest = padding(m_position, alignment); rest > 0;) {
+        const std::size_t chunk = rest < skipped.size() ? rest : skipped.size();
+        read_bytes(skipped.data(), chunk);
+        rest -= chunk;
+    }
+}
+
+void BinaryReader::read_header() {
+    std::array<std::byte, HEADER_SIZE> header{};
+    read_bytes(header.data(), header.size());
+    check_header(header.data(), header.size());
+}
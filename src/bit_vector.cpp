@@ -0,0 +1,185 @@
+#include "bit_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+std::size_t BitVector::popcount(const std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    std::size_t count = 0;
+
+    for (std::uint64_t rest = word; rest != 0; rest &= rest - 1)
+        ++count;
+
+    return count;
+#endif
+}
+
+std::size_t BitVector::select_in_word(const std::uint64_t word, const std::size_t k) {
+    std::uint64_t rest = word;
+
+    for (std::size_t i = 0; i < k; ++i)
+        rest &= rest - 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(rest);
+#else
+    std::size_t pos = 0;
+
+    while ((rest & 1) == 0) {
+        rest >>= 1;
+        ++pos;
+    }
+
+    return pos;
+#endif
+}
+
+std::size_t BitVector::zeros_before_block(const std::size_t block) const {
+    return (block * BLOCK_BITS) - m_block_ranks[block];
+}
+
+void BitVector::check_index() const {
+    if (m_block_ranks.is_empty())
+        throw std::logic_error("BitVector index has not been built");
+}
+
+std::size_t BitVector::size() const {
+    return m_size;
+}
+
+bool BitVector::is_empty() const {
+    return m_size == 0;
+}
+
+void BitVector::push(const bool bit) {
+    if (!m_block_ranks.is_empty())
+        m_block_ranks.clear();
+
+    if (m_size % WORD_BITS == 0)
+        m_words.push(0);
+
+    if (bit)
+        m_words.last() |= std::uint64_t{1} << (m_size % WORD_BITS);
+
+    ++m_size;
+}
+
+void BitVector::build_index() {
+    const std::size_t blocks = (m_words.size() + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    m_block_ranks = Vec<std::uint64_t>(blocks + 1);
+
+    std::uint64_t ones = 0;
+
+    for (std::size_t i = 0; i < m_words.size(); ++i) {
+        if (i % BLOCK_WORDS == 0)
+            m_block_ranks[i / BLOCK_WORDS] = ones;
+
+        ones += popcount(m_words[i]);
+    }
+
+    m_block_ranks[blocks] = ones;
+}
+
+bool BitVector::operator[](const std::size_t index) const {
+    if (index >= m_size)
+        throw std::out_of_range("Index out of bounds");
+
+    return ((m_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1) != 0;
+}
+
+std::size_t BitVector::rank1(const std::size_t pos) const {
+    check_index();
+
+    if (pos > m_size)
+        throw std::out_of_range("Index out of bounds");
+
+    const std::size_t word = pos / WORD_BITS;
+    std::size_t rank = m_block_ranks[pos / BLOCK_BITS];
+
+    for (std::size_t i = (pos / BLOCK_BITS) * BLOCK_WORDS; i < word; ++i)
+        rank += popcount(m_words[i]);
+
+    if (pos % WORD_BITS != 0)
+        rank += popcount(m_words[word] & ((std::uint64_t{1} << (pos % WORD_BITS)) - 1));
+
+    return rank;
+}
+
+std::size_t BitVector::rank0(const std::size_t pos) const {
+    return pos - rank1(pos);
+}
+
+std::size_t BitVector::select1(const std::size_t k) const {
+    check_index();
+
+    const std::size_t blocks = m_block_ranks.size() - 1;
+
+    if (blocks == 0 || k >= m_block_ranks[blocks])
+        throw std::out_of_range("Not enough set bits");
+
+    // Last block with fewer than k + 1 ones before it.
+    std::size_t lo = 0;
+    std::size_t hi = blocks;
+
+    while (hi - lo > 1) {
+        const std::size_t mid = lo + ((hi - lo) / 2);
+
+        if (m_block_ranks[mid] <= k)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    std::size_t remaining = k - m_block_ranks[lo];
+    std::size_t word = lo * BLOCK_WORDS;
+
+    while (true) {
+        const std::size_t ones = popcount(m_words[word]);
+
+        if (remaining < ones)
+            return (word * WORD_BITS) + select_in_word(m_words[word], remaining);
+
+        remaining -= ones;
+        ++word;
+    }
+}
+
+std::size_t BitVector::select0(const std::size_t k) const {
+    check_index();
+
+    const std::size_t blocks = m_block_ranks.size() - 1;
+
+    if (blocks == 0 || k >= m_size - m_block_ranks[blocks])
+        throw std::out_of_range("Not enough unset bits");
+
+    std::size_t lo = 0;
+    std::size_t hi = blocks;
+
+    while (hi - lo > 1) {
+        const std::size_t mid = lo + ((hi - lo) / 2);
+
+        if (zeros_before_block(mid) <= k)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    std::size_t remaining = k - zeros_before_block(lo);
+    std::size_t word = lo * BLOCK_WORDS;
+
+    while (true) {
+        // Padding bits past m_size are zero in storage; the bounds check above keeps us from
+        // ever selecting one of them.
+        const std::uint64_t inverted = ~m_words[word];
+        const std::size_t zeros = popcount(inverted);
+
+        if (remaining < zeros)
+            return (word * WORD_BITS) + select_in_word(inverted, remaining);
+
+        remaining -= zeros;
+        ++word;
+    }
+}
@@ -0,0 +1 @@
+#include "compare.h"
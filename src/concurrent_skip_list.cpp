@@ -0,0 +1 @@
+#include "concurrent_skip_list.h"
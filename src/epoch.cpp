@@ -0,0 +1 @@
+#include "epoch.h"
@@ -0,0 +1 @@
+#include "frozen_trie_map.h"
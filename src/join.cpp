@@ -0,0 +1 @@
+#include "join.h"
@@ -0,0 +1 @@
+#include "k_way_merge.h"
@@ -0,0 +1,108 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace {
+    [[noreturn]] void throw_errno(const char* const what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+}
+
+void MappedFile::map() {
+    if (m_size == 0)
+        return;
+
+    const int protection = m_mode == Mode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* const addr = mmap(nullptr, m_size, protection, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED)
+        throw_errno("mmap");
+
+    m_data = static_cast<std::byte*>(addr);
+}
+
+void MappedFile::unmap() {
+    if (m_data != nullptr)
+        munmap(std::exchange(m_data, nullptr), m_size);
+}
+
+void MappedFile::swap(MappedFile& other) noexcept {
+    std::swap(m_fd, other.m_fd);
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_mode, other.m_mode);
+}
+
+MappedFile::MappedFile(const std::string& path, const Mode mode)
+    : m_fd(mode == Mode::ReadOnly ? open(path.c_str(), O_RDONLY)
+                                  : open(path.c_str(), O_RDWR | O_CREAT, 0644)),
+      m_mode(mode) {
+    if (m_fd < 0)
+        throw_errno("open");
+
+    struct stat info{};
+    if (fstat(m_fd, &info) != 0) {
+        close(m_fd);
+        throw_errno("fstat");
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+
+    try {
+        map();
+    } catch (...) {
+        close(m_fd);
+        throw;
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    swap(other);
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+
+    if (m_fd >= 0)
+        close(std::exchange(m_fd, -1));
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    swap(other);
+    return *this;
+}
+
+std::size_t MappedFile::size() const {
+    return m_size;
+}
+
+std::byte* MappedFile::data() {
+    return m_data;
+}
+
+const std::byte* MappedFile::data() const {
+    return m_data;
+}
+
+void MappedFile::resize(const std::size_t new_size) {
+    unmap();
+
+    if (ftruncate(m_fd, static_cast<off_t>(new_size)) != 0)
+        throw_errno("ftruncate");
+
+    m_size = new_size;
+    map();
+}
+
+void MappedFile::flush() {
+    if (m_data != nullptr && msync(m_data, m_size, MS_SYNC) != 0)
+        throw_errno("msync");
+}
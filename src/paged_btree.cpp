@@ -0,0 +1 @@
+#include "paged_btree.h"
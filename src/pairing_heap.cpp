@@ -0,0 +1 @@
+#include "pairing_heap.h"
@@ -0,0 +1 @@
+#include "persistent_avl_tree.h"
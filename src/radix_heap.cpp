@@ -0,0 +1 @@
+#include "radix_heap.h"
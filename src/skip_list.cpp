@@ -0,0 +1 @@
+#include "skip_list.h"
@@ -0,0 +1 @@
+#include "splay_tree.h"
@@ -0,0 +1 @@
+#include "static_search_tree.h"
@@ -0,0 +1 @@
+#include "tagged_ptr.h"
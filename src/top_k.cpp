@@ -0,0 +1 @@
+#include "top_k.h"
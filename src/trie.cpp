@@ -1,61 +1,79 @@
 #include "trie.h"
+#include "binary_io.h"
+#include "frozen_trie_map.h"
+#include "trie_map.h"
 
-#include <array>
 #include <cstddef>
-#include <stdexcept>
+#include <optional>
 #include <string_view>
+#include <variant>
 
-std::size_t Trie::idx(const char ch) {
-    return ch - 'a';
-}
+template class TrieMap<std::monostate>;
+template class FrozenTrieMap<std::monostate>;
 
-void Trie::insert(const std::string_view word) {
-    Node** cur = &root;
+std::size_t Trie::size() const {
+    return map.size();
+}
 
-    for (const char ch : word) {
-        if (ch < 'a' || ch > 'z')
-            throw std::runtime_error("Trie only accepts lowercase ASCII characters.");
+bool Trie::is_empty() const {
+    return map.is_empty();
+}
 
-        if (*cur == nullptr)
-            *cur = new Node();
+bool Trie::insert(const std::string_view word) {
+    return map.insert(word, std::monostate{});
+}
 
-        cur = &(*cur)->children.at(idx(ch));
-    }
+bool Trie::remove(const std::string_view word) {
+    return map.remove(word);
+}
 
-    if (*cur == nullptr)
-        *cur = new Node();
+bool Trie::contains(const std::string_view word) const {
+    return map.contains(word);
+}
 
-    (*cur)->is_end = true;
+bool Trie::has_prefix(const std::string_view prefix) const {
+    return map.has_prefix(prefix);
 }
 
-bool Trie::contains(const std::string_view word) const {
-    if (root == nullptr)
-        return false;
+std::optional<std::size_t> Trie::longest_prefix(const std::string_view text) const {
+    const auto match = map.longest_prefix(text);
 
-    Node* cur = root;
+    if (!match.has_value())
+        return std::nullopt;
 
-    for (const char ch : word) {
-        cur = cur->children.at(idx(ch));
+    return match->first;
+}
 
-        if (cur == nullptr)
-            return false;
-    }
+Trie::const_range Trie::find_prefix(const std::string_view prefix) const {
+    return map.find_prefix(prefix);
+}
 
-    return cur->is_end;
+void Trie::compact() {
+    map.compact();
 }
 
-bool Trie::has_prefix(const std::string_view prefix) const {
-    if (root == nullptr)
-        return false;
+FrozenTrie Trie::freeze() const {
+    return map.freeze();
+}
 
-    Node* cur = root;
+void Trie::clear() {
+    map.clear();
+}
 
-    for (const char ch : prefix) {
-        cur = cur->children.at(idx(ch));
+void Trie::serialize(BinaryWriter& writer) const {
+    map.serialize(writer);
+}
+
+Trie Trie::deserialize(BinaryReader& reader) {
+    Trie trie;
+    trie.map = TrieMap<std::monostate>::deserialize(reader);
+    return trie;
+}
 
-        if (cur == nullptr)
-            return false;
-    }
+Trie::const_iterator Trie::begin() const {
+    return map.begin();
+}
 
-    return true;
+Trie::const_iterator Trie::end() const {
+    return map.end();
 }
@@ -0,0 +1 @@
+#include "trie_map.h"
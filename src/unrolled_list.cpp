@@ -0,0 +1 @@
+#include "unrolled_list.h"
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "aho_corasick.h"
+#include "trie.h"
+
+namespace {
+    std::vector<std::pair<std::size_t, std::string>> matches_of(const AhoCorasick& ac,
+                                                                const std::string_view text) {
+        std::vector<std::pair<std::size_t, std::string>> result;
+
+        ac.for_each_match(text, [&](const AhoCorasick::Match& match) {
+            result.emplace_back(match.start, ac.pattern(match.pattern));
+        });
+
+        return result;
+    }
+
+    // Reference result: every (start, pattern) pair, sorted by end position then length.
+    std::vector<std::pair<std::size_t, std::string>> naive_matches(
+        const std::vector<std::string>& patterns,
+        const std::string_view text) {
+        std::vector<std::pair<std::size_t, std::string>> result;
+
+        for (std::size_t end = 1; end <= text.size(); ++end) {
+            std::vector<std::string> ending_here;
+
+            for (const std::string& pattern : patterns) {
+                if (pattern.size() <= end && text.substr(end - pattern.size(), pattern.size()) ==
+                                                 std::string_view(pattern))
+                    ending_here.push_back(pattern);
+            }
+
+            std::sort(ending_here.begin(), ending_here.end(),
+                      [](const std::string& a, const std::string& b) {
+                          return a.size() > b.size();
+                      });
+
+            for (const std::string& pattern : ending_here)
+                result.emplace_back(end - pattern.size(), pattern);
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("AhoCorasick with no patterns", "[aho_corasick]") {
+    const Trie trie;
+    const AhoCorasick ac(trie);
+
+    REQUIRE(ac.pattern_count() == 0);
+    REQUIRE(ac.find_all("anything").is_empty());
+    REQUIRE_FALSE(ac.contains_any("anything"));
+}
+
+TEST_CASE("AhoCorasick classic example", "[aho_corasick]") {
+    Trie trie;
+    trie.insert("he");
+    trie.insert("she");
+    trie.insert("his");
+    trie.insert("hers");
+
+    const AhoCorasick ac(trie);
+    REQUIRE(ac.pattern_count() == 4);
+
+    const auto found = matches_of(ac, "ushers");
+    REQUIRE(found == std::vector<std::pair<std::size_t, std::string>>{
+                         {1, "she"}, {2, "he"}, {2, "hers"}});
+
+    REQUIRE(ac.contains_any("this"));
+    REQUIRE_FALSE(ac.contains_any("xyz"));
+}
+
+TEST_CASE("AhoCorasick find_all reports positions and ids", "[aho_corasick]") {
+    Trie trie;
+    trie.insert("error");
+    trie.insert("warn");
+
+    const AhoCorasick ac(trie);
+    const Vec<AhoCorasick::Match> found = ac.find_all("warn: error, error");
+
+    REQUIRE(found.size() == 3);
+    REQUIRE(ac.pattern(found[0].pattern) == "warn");
+    REQUIRE(found[0].start == 0);
+    REQUIRE(ac.pattern(found[1].pattern) == "error");
+    REQUIRE(found[1].start == 6);
+    REQUIRE(found[2].start == 13);
+    REQUIRE_THROWS_AS(ac.pattern(2), std::out_of_range);
+}
+
+TEST_CASE("AhoCorasick matches a naive scan", "[aho_corasick]") {
+    const std::vector<std::string> patterns = {
+        "a", "ab", "bab", "bc", "bca", "c", "caa", "aaaa", std::string("\xff\x00z", 3), "b\xff"};
+    Trie trie;
+
+    for (const std::string& pattern : patterns)
+        trie.insert(pattern);
+
+    const AhoCorasick ac(trie);
+
+    std::string text;
+    for (std::size_t i = 0; i < 400; ++i)
+        text += "abc\xffz"[(i * i + 3 * i) % 5];
+
+    text += std::string("\xff\x00z", 3) + "aaaaaa";
+
+    REQUIRE(ac.pattern_count() == patterns.size());
+    REQUIRE(matches_of(ac, text) == naive_matches(patterns, text));
+}
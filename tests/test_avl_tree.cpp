@@ -1,7 +1,10 @@
 #include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <cmath>
+#include <functional>
+#include <map>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -245,3 +248,280 @@ TEST_CASE("Edge cases: extreme small trees and repeated remove/insert",
 
     REQUIRE_FALSE(t.remove(42));
 }
+
+TEST_CASE("Nodes store a packed balance factor instead of a height", "[avl][layout]") {
+    struct Bare {
+        int key;
+        int value;
+        void* left;
+        void* right;
+    };
+
+    REQUIRE(AvlTree<int, int>::NODE_SIZE == sizeof(Bare));
+}
+
+TEST_CASE("Balance factors stay consistent", "[avl][balance]") {
+    AvlTree<int, int> t;
+    std::vector<int> keys(2000);
+    for (int i = 0; i < 2000; ++i)
+        keys[i] = i;
+
+    std::mt19937 g(7);
+    std::shuffle(keys.begin(), keys.end(), g);
+
+    for (int k : keys) {
+        REQUIRE(t.insert(k, k));
+        REQUIRE(t.check_properties());
+    }
+
+    REQUIRE(t.height() <= static_cast<std::ptrdiff_t>(avl_height_upper_bound(t.size())));
+
+    std::shuffle(keys.begin(), keys.end(), g);
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(t.remove(keys[i]));
+        REQUIRE(t.check_properties());
+
+        if (i % 100 == 0) {
+            const std::size_t n = t.size();
+            REQUIRE(t.height() <= static_cast<std::ptrdiff_t>(avl_height_upper_bound(n)));
+        }
+    }
+
+    REQUIRE(t.height() == -1);
+
+    // Sorted input exercises the single rotations only.
+    for (int i = 0; i < 1024; ++i)
+        t.insert(i, i);
+
+    REQUIRE(t.check_properties());
+    REQUIRE(t.height() == 10);
+
+    const AvlTree<int, int> copy = t;
+    REQUIRE(copy.check_properties());
+    REQUIRE(copy.height() == 10);
+}
+
+TEST_CASE("Order statistics with SubtreeSize", "[avl][augment]") {
+    AvlTree<int, int, std::less<int>, SubtreeSize> tree;
+    std::vector<int> keys;
+
+    std::mt19937 rng(11);
+    for (int i = 0; i < 2000; ++i) {
+        const int key = static_cast<int>(rng() % 5000);
+
+        if (tree.insert(key, -key))
+            keys.push_back(key);
+    }
+
+    // Remove a third of them, including nodes with two children.
+    for (std::size_t i = 0; i < keys.size(); i += 3)
+        REQUIRE(tree.remove(keys[i]));
+
+    std::vector<int> remaining;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (i % 3 != 0)
+            remaining.push_back(keys[i]);
+    }
+
+    std::sort(remaining.begin(), remaining.end());
+    REQUIRE(tree.summary()->size == remaining.size());
+
+    for (std::size_t i = 0; i < remaining.size(); ++i) {
+        REQUIRE(tree.select(i).first == remaining[i]);
+        REQUIRE(tree.select(i).second == -remaining[i]);
+        REQUIRE(tree.rank(remaining[i]) == i);
+    }
+
+    REQUIRE_THROWS_AS(tree.select(remaining.size()), std::out_of_range);
+
+    for (int lo = -10; lo < 5010; lo += 97) {
+        for (int hi = lo - 5; hi < 5010; hi += 311) {
+            const auto expected = std::count_if(remaining.begin(), remaining.end(), [&](int k) {
+                return lo <= k && k <= hi;
+            });
+
+            REQUIRE(tree.count_range(lo, hi) == static_cast<std::size_t>(expected));
+        }
+    }
+
+    // Copies keep their augmentation.
+    const auto copy = tree;
+    REQUIRE(copy.select(10).first == remaining[10]);
+}
+
+namespace {
+    // Custom augmentation: the largest value in each subtree.
+    struct SubtreeMax {
+        struct Data {
+            int max = 0;
+        };
+
+        template<typename K>
+        static void update(Data& data,
+                           const K&,
+                           const int& value,
+                           const Data* const left,
+                           const Data* const right) {
+            data.max = value;
+
+            if (left != nullptr)
+                data.max = std::max(data.max, left->max);
+
+            if (right != nullptr)
+                data.max = std::max(data.max, right->max);
+        }
+    };
+}
+
+TEST_CASE("Custom augmentation tracks value updates", "[avl][augment]") {
+    AvlTree<int, int, std::less<int>, SubtreeMax> tree;
+
+    REQUIRE(tree.summary() == nullptr);
+
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i, i % 10);
+
+    REQUIRE(tree.summary()->max == 9);
+
+    tree.insert(50, 1000);
+    REQUIRE(tree.summary()->max == 1000);
+
+    tree.insert(50, 3);
+    REQUIRE(tree.summary()->max == 9);
+
+    for (int i = 0; i < 100; ++i) {
+        if (i % 10 == 9)
+            tree.remove(i);
+    }
+
+    REQUIRE(tree.summary()->max == 8);
+}
+
+TEST_CASE("AVL split and join", "[avl][join]") {
+    using Tree = AvlTree<int, int, std::less<int>, SubtreeSize>;
+
+    for (int pivot = -5; pivot < 310; pivot += 7) {
+        Tree tree;
+        for (int i = 0; i < 300; ++i)
+            tree.insert(i, i * 2);
+
+        auto upper = tree.split(pivot);
+        const auto expected_upper = static_cast<std::size_t>(std::clamp(300 - pivot, 0, 300));
+
+        REQUIRE(tree.check_properties());
+        REQUIRE(upper.check_properties());
+        REQUIRE(upper.size() == expected_upper);
+        REQUIRE(tree.size() == 300 - expected_upper);
+
+        if (!upper.is_empty()) {
+            REQUIRE(upper.summary()->size == expected_upper);
+            REQUIRE(upper.select(0).first == std::max(pivot, 0));
+        }
+
+        auto joined = Tree::join(std::move(tree), std::move(upper));
+
+        REQUIRE(joined.check_properties());
+        REQUIRE(joined.size() == 300);
+        REQUIRE(joined.rank(150) == 150);
+        REQUIRE(tree.is_empty());
+        REQUIRE(upper.is_empty());
+    }
+
+    AvlTree<int, int> low;
+    AvlTree<int, int> high;
+    low.insert(5, 5);
+    high.insert(5, 5);
+
+    REQUIRE_THROWS_AS((AvlTree<int, int>::join(low, high)), std::invalid_argument);
+
+    // Trees of very different heights.
+    for (int i = 6; i < 5000; ++i)
+        high.insert(i, i);
+
+    high.remove(5);
+    const auto joined = AvlTree<int, int>::join(low, high);
+
+    REQUIRE(joined.check_properties());
+    REQUIRE(joined.size() == 4995);
+}
+
+TEST_CASE("AVL set operations", "[avl][join]") {
+    std::mt19937 rng(42);
+
+    for (int round = 0; round < 20; ++round) {
+        const int range = 50 + round * 400;
+        std::map<int, int> a_model;
+        std::map<int, int> b_model;
+        AvlTree<int, int> a;
+        AvlTree<int, int> b;
+
+        for (int i = 0; i < range / (1 + round % 4); ++i) {
+            const int key = static_cast<int>(rng() % range);
+            a.insert(key, key);
+            a_model[key] = key;
+        }
+
+        for (int i = 0; i < range / (1 + round % 3); ++i) {
+            const int key = static_cast<int>(rng() % range);
+            b.insert(key, -key);
+            b_model[key] = -key;
+        }
+
+        const auto execution = round % 2 == 0 ? Execution::Sequential : Execution::Parallel;
+
+        auto united = a;
+        united.union_with(b, execution);
+        auto united_model = b_model;
+        united_model.insert(a_model.begin(), a_model.end());
+
+        auto common = a;
+        common.intersect_with(b, execution);
+
+        auto rest = a;
+        rest.difference_with(b, execution);
+
+        REQUIRE(united.check_properties());
+        REQUIRE(common.check_properties());
+        REQUIRE(rest.check_properties());
+        REQUIRE(united.size() == united_model.size());
+
+        std::size_t common_size = 0;
+
+        for (const auto& [key, value] : united_model)
+            REQUIRE(united.get(key) == value);
+
+        for (const auto& [key, value] : a_model) {
+            const bool shared = b_model.count(key) != 0;
+
+            REQUIRE(common.contains(key) == shared);
+            REQUIRE(rest.contains(key) == !shared);
+
+            if (shared) {
+                REQUIRE(common.get(key) == value);
+                ++common_size;
+            }
+        }
+
+        REQUIRE(common.size() == common_size);
+        REQUIRE(rest.size() == a_model.size() - common_size);
+    }
+}
+
+TEST_CASE("AVL parallel union of large trees", "[avl][join]") {
+    AvlTree<int, int, std::less<int>, SubtreeSize> evens;
+    AvlTree<int, int, std::less<int>, SubtreeSize> thirds;
+
+    for (int i = 0; i < 60000; ++i) {
+        evens.insert(i * 2, i);
+        thirds.insert(i * 3, i);
+    }
+
+    evens.union_with(std::move(thirds), Execution::Parallel);
+
+    REQUIRE(thirds.is_empty());
+    REQUIRE(evens.check_properties());
+    REQUIRE(evens.size() == 60000 + 60000 - 20000);
+    REQUIRE(evens.summary()->size == evens.size());
+    REQUIRE(evens.select(3).first == 4);
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #include "binary_heap.h"
 
 TEST_CASE("BinaryHeap basic properties", "[binary_heap]") {
@@ -377,3 +379,78 @@ TEST_CASE("BinaryHeap initializer list constructor") {
     REQUIRE(heap.pop() == 6);
     REQUIRE(heap.pop() == 7);
 }
+
+TEST_CASE("BinaryHeap from Vec heapifies in place", "[binary_heap]") {
+    Vec<int> elements;
+    for (int i = 100; i > 0; --i)
+        elements.push((i * 37) % 101);
+
+    BinaryHeap<int> heap(std::move(elements));
+    REQUIRE(heap.size() == 100);
+
+    int prev = heap.pop();
+    while (!heap.is_empty()) {
+        const int cur = heap.pop();
+        REQUIRE(prev <= cur);
+        prev = cur;
+    }
+}
+
+TEST_CASE("BinaryHeap from iterator range", "[binary_heap]") {
+    const std::vector<int> values = {9, 4, 8, 1, 7, 3, 6, 2, 5, 0};
+
+    BinaryHeap<int, std::greater<>> heap(values.begin(), values.end());
+    REQUIRE(heap.size() == values.size());
+
+    for (int i = 9; i >= 0; --i)
+        REQUIRE(heap.pop() == i);
+
+    REQUIRE(heap.is_empty());
+}
+
+TEST_CASE("BinaryHeap push_bulk", "[binary_heap]") {
+    SECTION("Few elements into a large heap") {
+        BinaryHeap<int> heap;
+        for (int i = 0; i < 1000; ++i)
+            heap.push(i + 10);
+
+        const std::vector<int> extra = {5, 3, 2000};
+        heap.push_bulk(extra.begin(), extra.end());
+
+        REQUIRE(heap.size() == 1003);
+        REQUIRE(heap.pop() == 3);
+        REQUIRE(heap.pop() == 5);
+        REQUIRE(heap.pop() == 10);
+    }
+
+    SECTION("Many elements into a small heap") {
+        BinaryHeap<int> heap = {50, 40};
+
+        Vec<int> extra;
+        for (int i = 99; i >= 0; --i)
+            extra.push(i);
+
+        heap.push_bulk(std::move(extra));
+        REQUIRE(heap.size() == 102);
+
+        std::vector<int> popped;
+        while (!heap.is_empty())
+            popped.push_back(heap.pop());
+
+        REQUIRE(std::is_sorted(popped.begin(), popped.end()));
+        REQUIRE(popped.front() == 0);
+        REQUIRE(popped.back() == 99);
+    }
+}
+
+TEST_CASE("BinaryHeap replace_top", "[binary_heap]") {
+    BinaryHeap<int> heap = {4, 2, 6};
+
+    REQUIRE(heap.replace_top(5) == 2);
+    REQUIRE(heap.size() == 3);
+    REQUIRE(heap.pop() == 4);
+    REQUIRE(heap.pop() == 5);
+    REQUIRE(heap.pop() == 6);
+
+    REQUIRE_THROWS_AS(heap.replace_top(1), std::out_of_range);
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "bit_vector.h"
+
+TEST_CASE("BitVector empty", "[bit_vector]") {
+    BitVector bits;
+    bits.build_index();
+
+    REQUIRE(bits.size() == 0);
+    REQUIRE(bits.is_empty());
+    REQUIRE(bits.rank1(0) == 0);
+    REQUIRE_THROWS_AS(bits.select1(0), std::out_of_range);
+    REQUIRE_THROWS_AS(bits.select0(0), std::out_of_range);
+}
+
+TEST_CASE("BitVector requires an index for rank and select", "[bit_vector]") {
+    BitVector bits;
+    bits.push(true);
+    REQUIRE(bits[0]);
+    REQUIRE_THROWS_AS(bits.rank1(1), std::logic_error);
+
+    bits.build_index();
+    REQUIRE(bits.rank1(1) == 1);
+
+    bits.push(false);
+    REQUIRE_THROWS_AS(bits.select0(0), std::logic_error);
+}
+
+TEST_CASE("BitVector rank and select match a naive scan", "[bit_vector]") {
+    BitVector bits;
+    std::vector<bool> naive;
+
+    // Irregular pattern spanning several rank blocks.
+    for (std::size_t i = 0; i < 3000; ++i) {
+        const bool bit = (i * i + (i / 7)) % 5 < 2;
+        bits.push(bit);
+        naive.push_back(bit);
+    }
+
+    bits.build_index();
+    REQUIRE(bits.size() == naive.size());
+
+    std::vector<std::size_t> ones;
+    std::vector<std::size_t> zeros;
+    std::size_t rank = 0;
+
+    for (std::size_t i = 0; i < naive.size(); ++i) {
+        REQUIRE(bits[i] == naive[i]);
+        REQUIRE(bits.rank1(i) == rank);
+        REQUIRE(bits.rank0(i) == i - rank);
+
+        if (naive[i]) {
+            ones.push_back(i);
+            ++rank;
+        } else {
+            zeros.push_back(i);
+        }
+    }
+
+    REQUIRE(bits.rank1(naive.size()) == ones.size());
+
+    for (std::size_t k = 0; k < ones.size(); ++k)
+        REQUIRE(bits.select1(k) == ones[k]);
+
+    for (std::size_t k = 0; k < zeros.size(); ++k)
+        REQUIRE(bits.select0(k) == zeros[k]);
+
+    REQUIRE_THROWS_AS(bits.select1(ones.size()), std::out_of_range);
+    REQUIRE_THROWS_AS(bits.select0(zeros.size()), std::out_of_range);
+    REQUIRE_THROWS_AS(bits[naive.size()], std::out_of_range);
+}
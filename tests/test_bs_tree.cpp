@@ -394,3 +394,68 @@ TEST_CASE("Iterator on skewed tree (degenerate case)") {
         REQUIRE(keys == std::vector<int>{1, 2, 3, 4, 5});
     }
 }
+
+TEST_CASE("Height and validation on a deep degenerate tree") {
+    BSTree<int, int> tree;
+    constexpr int count = 20000;
+
+    for (int i = 0; i < count; ++i)
+        tree.insert(i, i);
+
+    REQUIRE(tree.height() == count - 1);
+    REQUIRE(tree.check_properties());
+}
+
+TEST_CASE("Scapegoat mode bounds the depth of sorted insertions") {
+    BSTree<int, int, std::less<int>, Rebalancing::Scapegoat> tree;
+    constexpr int count = 100000;
+
+    for (int i = 0; i < count; ++i)
+        tree.insert(i, i * 2);
+
+    REQUIRE(tree.size() == static_cast<std::size_t>(count));
+    REQUIRE(tree.check_properties());
+    REQUIRE(tree.height() <= 29);  // floor(log_{3/2}(100000)) + 1
+
+    for (int i = 0; i < count; ++i)
+        REQUIRE(tree.get(i) == i * 2);
+
+    int expected = 0;
+    for (auto [key, value] : tree) {
+        REQUIRE(key == expected);
+        REQUIRE(value == expected * 2);
+        ++expected;
+    }
+    REQUIRE(expected == count);
+}
+
+TEST_CASE("Scapegoat mode stays balanced through removals") {
+    BSTree<int, int, std::less<int>, Rebalancing::Scapegoat> tree;
+    std::vector<int> keys(5000);
+    for (int i = 0; i < 5000; ++i)
+        keys[i] = i;
+
+    for (int key : keys)
+        tree.insert(key, key);
+
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(tree.remove(keys[i]));
+
+        if (i % 500 == 0) {
+            REQUIRE(tree.check_properties());
+            REQUIRE(tree.height() <= 2 * 21 + 1);
+        }
+    }
+
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.height() == -1);
+
+    tree.insert(1, 1);
+    REQUIRE(tree.contains(1));
+
+    auto copy = tree;
+    REQUIRE(copy.check_properties());
+    REQUIRE(copy.get(1) == 1);
+}
@@ -124,3 +124,40 @@ TEST_CASE("main test", "[btree]") {
     REQUIRE(btree2.to_string(",") == "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20");
     REQUIRE(btree2.check_properties());
 }
+
+TEST_CASE("build_from_ordered_vector with unsorted or repeated keys", "[btree]") {
+    const Vec<std::pair<int, int>> unsorted = {
+        {5, 5},
+        {1, 1},
+        {4, 4},
+        {2, 2},
+        {3, 3},
+        {7, 7},
+        {6, 6}
+    };
+
+    const auto btree = BTree<int, int, std::less<>, 3>::build_from_ordered_vector(unsorted);
+
+    REQUIRE(btree.check_properties());
+    REQUIRE(btree.size() == 7);
+    REQUIRE(btree.to_string(",") == "1,2,3,4,5,6,7");
+
+    const Vec<std::pair<int, int>> repeated = {
+        {1, 1},
+        {2, 2},
+        {2, 20},
+        {3, 3},
+        {3, 30},
+        {3, 300}
+    };
+
+    auto btree2 = BTree<int, int>::build_from_ordered_vector(repeated);
+
+    REQUIRE(btree2.check_properties());
+    REQUIRE(btree2.size() == 3);
+    REQUIRE(btree2.get(2) == 20);
+    REQUIRE(btree2.get(3) == 300);
+    REQUIRE(btree2.remove(2));
+    REQUIRE_FALSE(btree2.contains_key(2));
+    REQUIRE(btree2.check_properties());
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "avl_tree.h"
+#include "bs_tree.h"
+#include "btree.h"
+#include "compare.h"
+#include "red_black_tree.h"
+
+namespace {
+    std::size_t g_calls = 0;
+
+    // Counts how often the trees compare keys, through either interface.
+    struct CountingCompare {
+        bool operator()(const std::string& a, const std::string& b) const {
+            ++g_calls;
+            return a < b;
+        }
+
+        int compare(const std::string& a, const std::string& b) const {
+            ++g_calls;
+            return a.compare(b);
+        }
+    };
+
+    // Provides nothing but a less-than.
+    struct Reversed {
+        bool operator()(const int a, const int b) const {
+            return a > b;
+        }
+    };
+
+    struct Point {
+        int x;
+        int y;
+    };
+
+    struct PointLess {
+        bool operator()(const Point& a, const Point& b) const {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        }
+    };
+
+    template<typename Tree>
+    void require_one_compare_per_level(Tree& tree) {
+        for (int i = 0; i < 1000; ++i)
+            tree.insert(std::to_string(i), i);
+
+        const auto depth_limit = static_cast<std::size_t>(tree.height()) + 1;
+
+        for (int i = 0; i < 1000; ++i) {
+            g_calls = 0;
+            REQUIRE(tree.get(std::to_string(i)) == i);
+            REQUIRE(g_calls <= depth_limit);
+        }
+
+        g_calls = 0;
+        REQUIRE(!tree.contains("missing"));
+        REQUIRE(g_calls <= depth_limit);
+    }
+}
+
+TEST_CASE("three_way", "[compare]") {
+    REQUIRE(three_way(std::less<int>(), 1, 2) < 0);
+    REQUIRE(three_way(std::less<int>(), 2, 2) == 0);
+    REQUIRE(three_way(std::less<int>(), 3, 2) > 0);
+
+    REQUIRE(three_way(std::less<std::string>(), std::string("abc"), std::string("abd")) < 0);
+    REQUIRE(three_way(std::less<>(), std::string("b"), std::string("a")) > 0);
+
+    REQUIRE(three_way(Reversed(), 1, 2) > 0);
+    REQUIRE(three_way(Reversed(), 2, 2) == 0);
+
+    g_calls = 0;
+    REQUIRE(three_way(CountingCompare(), std::string("x"), std::string("x")) == 0);
+    REQUIRE(g_calls == 1);
+}
+
+TEST_CASE("binary trees compare once per level", "[compare]") {
+    AvlTree<std::string, int, CountingCompare> avl;
+    RedBlackTree<std::string, int, CountingCompare> rbt;
+    BSTree<std::string, int, CountingCompare> bst;
+
+    require_one_compare_per_level(avl);
+    require_one_compare_per_level(rbt);
+    require_one_compare_per_level(bst);
+
+    g_calls = 0;
+    REQUIRE(avl.remove("500"));
+    REQUIRE(rbt.remove("500"));
+    REQUIRE(g_calls <= static_cast<std::size_t>(avl.height() + rbt.height()) + 2);
+}
+
+TEST_CASE("keys need no equality operator", "[compare]") {
+    BTree<Point, int, PointLess> btree;
+    AvlTree<Point, int, PointLess> avl;
+    BSTree<Point, int, PointLess> bst;
+
+    for (int i = 0; i < 200; ++i) {
+        btree.insert({i % 20, i / 20}, i);
+        avl.insert({i % 20, i / 20}, i);
+        bst.insert({i % 20, i / 20}, i);
+    }
+
+    REQUIRE(btree.check_properties());
+    REQUIRE(btree.get({3, 4}) == 83);
+    REQUIRE(avl.get({3, 4}) == 83);
+    REQUIRE(bst.get({3, 4}) == 83);
+
+    REQUIRE(btree.remove({3, 4}));
+    REQUIRE(!btree.contains_key({3, 4}));
+    REQUIRE(avl.remove({3, 4}));
+    REQUIRE(bst.remove({3, 4}));
+}
+
+TEST_CASE("less-than only comparators still work", "[compare]") {
+    AvlTree<int, int, Reversed> tree;
+
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i, i);
+
+    REQUIRE(tree.check_properties());
+    REQUIRE(tree.get(42) == 42);
+    REQUIRE(tree.remove(42));
+    REQUIRE(!tree.contains(42));
+}
@@ -0,0 +1,208 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_skip_list.h"
+#include "epoch.h"
+
+namespace {
+    std::atomic<int> g_live{0};
+
+    // Counts the instances alive, to catch leaks and double frees.
+    struct Tracked {
+        int value = 0;
+
+        explicit Tracked(const int value = 0)
+            : value(value) {
+            ++g_live;
+        }
+
+        Tracked(const Tracked& other)
+            : value(other.value) {
+            ++g_live;
+        }
+
+        ~Tracked() {
+            --g_live;
+        }
+    };
+
+    constexpr int THREADS = 4;
+
+    template<typename F>
+    void run_threads(F&& body) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+            threads.emplace_back(body, t);
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    template<typename List>
+    bool is_sorted(const List& list, const int begin, const int end) {
+        const auto entries = list.range_search(begin, end);
+
+        for (std::size_t i = 1; i < entries.size(); ++i) {
+            if (!(entries[i - 1].first < entries[i].first))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+TEST_CASE("EpochDomain frees retired memory") {
+    g_live = 0;
+
+    {
+        EpochDomain domain;
+
+        for (int i = 0; i < 1000; ++i) {
+            auto guard = domain.pin();
+            guard.retire(new Tracked(i));
+        }
+
+        // Unpinning repeatedly lets the epoch advance and most of the memory go.
+        REQUIRE(g_live < 1000);
+    }
+
+    REQUIRE(g_live == 0);
+}
+
+TEST_CASE("ConcurrentSkipList single-threaded behaviour") {
+    ConcurrentSkipList<int, std::string> list;
+
+    REQUIRE(list.is_empty());
+    REQUIRE_FALSE(list.contains(1));
+    REQUIRE_FALSE(list.find(1).has_value());
+    REQUIRE_THROWS_AS(list.get(1), std::out_of_range);
+    REQUIRE_FALSE(list.remove(1));
+
+    REQUIRE(list.insert(2, "two"));
+    REQUIRE(list.insert(1, "one"));
+    REQUIRE_FALSE(list.insert(2, "TWO"));
+
+    REQUIRE(list.size() == 2);
+    REQUIRE(list.get(2) == "TWO");
+    REQUIRE(*list.find(1) == "one");
+
+    const auto entries = list.range_search(0, 10);
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].first == 1);
+    REQUIRE(entries[1].second == "TWO");
+
+    REQUIRE(list.remove(1));
+    REQUIRE_FALSE(list.contains(1));
+    REQUIRE(list.size() == 1);
+}
+
+TEST_CASE("ConcurrentSkipList matches std::map under random operations") {
+    ConcurrentSkipList<int, int> list;
+    std::map<int, int> expected;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> keys(0, 499);
+
+    for (int i = 0; i < 20000; ++i) {
+        const int key = keys(rng);
+
+        switch (rng() % 3) {
+            case 0:
+                REQUIRE(list.insert(key, i) == (expected.count(key) == 0));
+                expected[key] = i;
+                break;
+            case 1:
+                REQUIRE(list.remove(key) == (expected.erase(key) == 1));
+                break;
+            default:
+                REQUIRE(list.contains(key) == (expected.count(key) == 1));
+                break;
+        }
+    }
+
+    const auto entries = list.range_search(0, 499);
+    REQUIRE(entries.size() == expected.size());
+
+    auto it = expected.begin();
+    for (std::size_t i = 0; i < entries.size(); ++i, ++it) {
+        REQUIRE(entries[i].first == it->first);
+        REQUIRE(entries[i].second == it->second);
+    }
+}
+
+TEST_CASE("Concurrent inserts while others scan") {
+    ConcurrentSkipList<int, int> list;
+    constexpr int per_thread = 20000;
+    std::atomic<bool> writing{true};
+    std::atomic<bool> ordered{true};
+
+    std::thread scanner([&] {
+        while (writing.load()) {
+            if (!is_sorted(list, 0, THREADS * per_thread))
+                ordered = false;
+        }
+    });
+
+    // Thread t inserts the keys equal to t modulo THREADS.
+    run_threads([&](const int t) {
+        for (int i = 0; i < per_thread; ++i)
+            list.insert(i * THREADS + t, t);
+    });
+
+    writing = false;
+    scanner.join();
+
+    REQUIRE(ordered);
+    REQUIRE(list.size() == static_cast<std::size_t>(THREADS * per_thread));
+
+    const auto entries = list.range_search(0, THREADS * per_thread);
+    REQUIRE(entries.size() == static_cast<std::size_t>(THREADS * per_thread));
+
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        REQUIRE(entries[i].first == static_cast<int>(i));
+        REQUIRE(entries[i].second == static_cast<int>(i) % THREADS);
+    }
+}
+
+TEST_CASE("Concurrent inserts and removals of the same keys") {
+    g_live = 0;
+
+    {
+        ConcurrentSkipList<int, Tracked> list;
+        constexpr int keys = 256;
+        std::atomic<int> balance{0};
+
+        run_threads([&](const int t) {
+            std::mt19937 rng(t);
+
+            for (int i = 0; i < 50000; ++i) {
+                const int key = static_cast<int>(rng() % keys);
+
+                if (rng() % 2 == 0) {
+                    if (list.insert(key, Tracked(i)))
+                        ++balance;
+                } else if (list.remove(key)) {
+                    --balance;
+                } else {
+                    static_cast<void>(list.find(key));
+                }
+            }
+        });
+
+        REQUIRE(list.size() == static_cast<std::size_t>(balance.load()));
+        REQUIRE(is_sorted(list, 0, keys));
+
+        const auto entries = list.range_search(0, keys);
+        REQUIRE(entries.size() == list.size());
+
+        for (const auto& [key, value] : entries)
+            REQUIRE(list.contains(key));
+    }
+
+    // Every value and node went back, whether it was removed, overwritten or still present.
+    REQUIRE(g_live == 0);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "frozen_trie_map.h"
+#include "trie.h"
+#include "trie_map.h"
+
+TEST_CASE("FrozenTrieMap of an empty map", "[frozen_trie_map]") {
+    const TrieMap<int> map;
+    const FrozenTrieMap<int> frozen = map.freeze();
+
+    REQUIRE(frozen.is_empty());
+    REQUIRE_FALSE(frozen.contains(""));
+    REQUIRE_FALSE(frozen.has_prefix(""));
+    REQUIRE_FALSE(frozen.longest_prefix("abc").has_value());
+    REQUIRE_THROWS_AS(frozen.get("a"), std::out_of_range);
+}
+
+TEST_CASE("FrozenTrieMap answers like the source map", "[frozen_trie_map]") {
+    TrieMap<int> map;
+    std::vector<std::string> keys;
+
+    for (int i = 0; i < 2000; ++i) {
+        keys.push_back("user/" + std::to_string((i * 7919) % 5000) + "/profile");
+        map.insert(keys.back(), i);
+    }
+
+    map.insert("user/", -1);
+    map.insert("", -2);
+
+    const FrozenTrieMap<int> frozen = map.freeze();
+    REQUIRE(frozen.size() == map.size());
+
+    for (int i = 0; i < 2000; ++i) {
+        REQUIRE(frozen.get(keys[i]) == i);
+        REQUIRE(frozen.has_prefix(keys[i].substr(0, 8)));
+    }
+
+    REQUIRE(frozen.get("user/") == -1);
+    REQUIRE(frozen.get("") == -2);
+    REQUIRE_FALSE(frozen.contains("user"));
+    REQUIRE_FALSE(frozen.contains("user/1/"));
+    REQUIRE_FALSE(frozen.contains("user/9999/profile"));
+    REQUIRE(frozen.find("nope") == nullptr);
+    REQUIRE_FALSE(frozen.has_prefix("users"));
+
+    const auto match = frozen.longest_prefix("user/123/settings");
+    REQUIRE(match.has_value());
+    REQUIRE(match->first == 5);
+    REQUIRE(*match->second == -1);
+
+    REQUIRE(frozen.longest_prefix("admin")->first == 0);
+    REQUIRE(frozen.longest_prefix(keys[3] + "/photo")->first == keys[3].size());
+
+    SECTION("Snapshot is independent of later changes") {
+        map.get(keys[0]) = 100;
+        map.remove(keys[1]);
+
+        REQUIRE(frozen.get(keys[0]) == 0);
+        REQUIRE(frozen.get(keys[1]) == 1);
+    }
+}
+
+TEST_CASE("FrozenTrie from Trie", "[frozen_trie_map]") {
+    Trie trie;
+    trie.insert("http://example.com/");
+    trie.insert("http://example.com/about");
+    trie.insert("https://example.org/");
+
+    const FrozenTrie frozen = trie.freeze();
+
+    REQUIRE(frozen.size() == 3);
+    REQUIRE(frozen.contains("http://example.com/about"));
+    REQUIRE(frozen.has_prefix("https"));
+    REQUIRE_FALSE(frozen.contains("http://example.com"));
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+#include "k_way_merge.h"
+#include "linked_list.h"
+#include "vec.h"
+
+TEST_CASE("KWayMerge with no sources", "[k_way_merge]") {
+    KWayMerge<const int*> merge({});
+
+    REQUIRE(merge.is_empty());
+    REQUIRE(merge.begin() == merge.end());
+    REQUIRE_THROWS_AS(merge.peek(), std::out_of_range);
+    REQUIRE_THROWS_AS(merge.pop(), std::out_of_range);
+}
+
+TEST_CASE("KWayMerge merges sorted Vecs", "[k_way_merge]") {
+    const Vec<int> a = {1, 4, 7, 10};
+    const Vec<int> b = {2, 5, 8};
+    const Vec<int> c = {};
+    const Vec<int> d = {0, 3, 6, 9, 11};
+
+    KWayMerge<const int*> merge(
+        {{a.begin(), a.end()}, {b.begin(), b.end()}, {c.begin(), c.end()}, {d.begin(), d.end()}});
+
+    for (int i = 0; i <= 11; ++i) {
+        REQUIRE_FALSE(merge.is_empty());
+        REQUIRE(merge.peek() == i);
+        REQUIRE(merge.pop() == i);
+    }
+
+    REQUIRE(merge.is_empty());
+}
+
+TEST_CASE("KWayMerge yields references into the sources", "[k_way_merge]") {
+    const Vec<std::string> a = {"apple", "cherry"};
+    const Vec<std::string> b = {"banana"};
+
+    KWayMerge<const std::string*> merge({{a.begin(), a.end()}, {b.begin(), b.end()}});
+
+    REQUIRE(&merge.peek() == &a[0]);
+    merge.advance();
+    REQUIRE(&merge.peek() == &b[0]);
+}
+
+TEST_CASE("KWayMerge over LinkedLists with a custom comparator", "[k_way_merge]") {
+    LinkedList<int> a;
+    LinkedList<int> b;
+
+    for (int i = 10; i > 0; i -= 2)
+        a.push_back(i);
+
+    for (int i = 9; i > 0; i -= 2)
+        b.push_back(i);
+
+    using Iter = LinkedList<int>::const_iterator;
+    const LinkedList<int>& ca = a;
+    const LinkedList<int>& cb = b;
+
+    KWayMerge<Iter, std::greater<>> merge({{ca.begin(), ca.end()}, {cb.begin(), cb.end()}});
+
+    std::vector<int> merged;
+    for (const int el : merge)
+        merged.push_back(el);
+
+    REQUIRE(merged == std::vector<int>{10, 9, 8, 7, 6, 5, 4, 3, 2, 1});
+}
+
+TEST_CASE("KWayMerge collapsing duplicates", "[k_way_merge]") {
+    const Vec<int> a = {1, 1, 2, 5, 5};
+    const Vec<int> b = {1, 2, 2, 3};
+    const Vec<int> c = {3, 5, 6};
+
+    SECTION("Keep duplicates") {
+        KWayMerge<const int*> merge(
+            {{a.begin(), a.end()}, {b.begin(), b.end()}, {c.begin(), c.end()}});
+
+        std::vector<int> merged(merge.begin(), merge.end());
+        REQUIRE(merged == std::vector<int>{1, 1, 1, 2, 2, 2, 3, 3, 5, 5, 5, 6});
+    }
+
+    SECTION("Collapse duplicates") {
+        KWayMerge<const int*> merge(
+            {{a.begin(), a.end()}, {b.begin(), b.end()}, {c.begin(), c.end()}}, true);
+
+        std::vector<int> merged(merge.begin(), merge.end());
+        REQUIRE(merged == std::vector<int>{1, 2, 3, 5, 6});
+    }
+}
+
+TEST_CASE("KWayMerge collapses duplicates without copying elements", "[k_way_merge]") {
+    struct Counted {
+        int key;
+        int* copies;
+
+        Counted(const int key, int* const copies)
+            : key(key),
+              copies(copies) {}
+
+        Counted(const Counted& other)
+            : key(other.key),
+              copies(other.copies) {
+            ++*copies;
+        }
+
+        Counted& operator=(const Counted&) = default;
+
+        bool operator<(const Counted& other) const {
+            return key < other.key;
+        }
+    };
+
+    int copies = 0;
+    std::vector<Counted> a;
+    std::vector<Counted> b;
+
+    for (const int key : {1, 1, 2, 4})
+        a.emplace_back(key, &copies);
+
+    for (const int key : {1, 3, 4, 4})
+        b.emplace_back(key, &copies);
+
+    copies = 0;
+    using Iter = std::vector<Counted>::const_iterator;
+    KWayMerge<Iter> merge({{a.cbegin(), a.cend()}, {b.cbegin(), b.cend()}}, true);
+
+    std::vector<int> merged;
+    for (const Counted& el : merge)
+        merged.push_back(el.key);
+
+    REQUIRE(merged == std::vector<int>{1, 2, 3, 4});
+    REQUIRE(copies == 0);
+}
+
+TEST_CASE("KWayMerge with many sources", "[k_way_merge]") {
+    const int K = 37;
+    const int N = 50;
+
+    Vec<Vec<int>> runs(K);
+    for (int i = 0; i < K * N; ++i)
+        runs[(i * 13) % K].push(i);
+
+    Vec<std::pair<const int*, const int*>> sources;
+    for (const Vec<int>& run : runs)
+        sources.push({run.begin(), run.end()});
+
+    KWayMerge<const int*> merge(std::move(sources));
+
+    for (int i = 0; i < K * N; ++i)
+        REQUIRE(merge.pop() == i);
+
+    REQUIRE(merge.is_empty());
+}
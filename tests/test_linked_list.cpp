@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 #include "linked_list.h"
@@ -227,3 +228,138 @@ TEST_CASE("iterator validity and behavior", "[linked_list]") {
         REQUIRE(it1 != it2);
     }
 }
+
+TEST_CASE("linked lists keep track of the back", "[linked_list]") {
+    LinkedList<int> list;
+    REQUIRE_THROWS_AS(list.back(), std::runtime_error);
+    REQUIRE_THROWS_AS(list.pop_back(), std::runtime_error);
+
+    list.push_front(2);
+    REQUIRE(list.back() == 2);
+    list.push_back(3);
+    list.push_front(1);
+    REQUIRE(list.back() == 3);
+
+    list.reverse();
+    REQUIRE(list.back() == 1);
+    list.push_back(0);
+    REQUIRE(list[3] == 0);
+
+    REQUIRE(list.pop_back() == 0);
+    REQUIRE(list.pop_back() == 1);
+    REQUIRE(list.back() == 2);
+
+    list.remove(++list.begin());
+    REQUIRE(list.back() == 3);
+    list.push_back(4);
+    REQUIRE(list[1] == 4);
+
+    LinkedList<int> copy(list);
+    copy.push_back(5);
+    REQUIRE(copy[2] == 5);
+    REQUIRE(list.back() == 4);
+
+    REQUIRE(list.pop_front() == 3);
+    REQUIRE(list.pop_front() == 4);
+    REQUIRE(list.is_empty());
+    list.push_back(6);
+    REQUIRE(list.front() == 6);
+    REQUIRE(list.back() == 6);
+
+    list.clear();
+    list.push_back(7);
+    REQUIRE(list.front() == 7);
+}
+
+TEST_CASE("linked lists work as queues", "[linked_list]") {
+    LinkedList<int> queue;
+
+    for (int i = 0; i < 1000000; ++i)
+        queue.push_back(i);
+
+    for (int i = 0; i < 1000000; ++i)
+        REQUIRE(queue.pop_front() == i);
+
+    REQUIRE(queue.is_empty());
+}
+
+TEST_CASE("linked lists support insert_after()", "[linked_list]") {
+    LinkedList<int> list;
+    list.push_back(1);
+    list.push_back(3);
+
+    auto it = list.insert_after(list.begin(), 2);
+    REQUIRE(*it == 2);
+
+    it = list.insert_after(++it, 4);
+    REQUIRE(*it == 4);
+    REQUIRE(++it == list.end());
+
+    list.push_back(5);
+    REQUIRE(list.size() == 5);
+
+    std::vector<int> values;
+    for (int el : list)
+        values.push_back(el);
+    REQUIRE(values == std::vector<int>{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("linked lists can be spliced", "[linked_list]") {
+    LinkedList<int> list;
+    list.push_back(1);
+    list.push_back(4);
+
+    LinkedList<int> middle;
+    middle.push_back(2);
+    middle.push_back(3);
+
+    auto it = ++list.begin();
+    list.splice(it, middle);
+
+    REQUIRE(*it == 2);
+    REQUIRE(middle.is_empty());
+    REQUIRE_THROWS_AS(middle.back(), std::runtime_error);
+    REQUIRE(list.size() == 4);
+    REQUIRE(list.back() == 4);
+
+    LinkedList<int> rest;
+    rest.push_back(5);
+    rest.push_back(6);
+    list.append(std::move(rest));
+
+    LinkedList<int> empty;
+    list.splice(list.begin(), empty);
+    list.append(std::move(empty));
+
+    REQUIRE(list.size() == 6);
+    REQUIRE(list.back() == 6);
+    list.push_back(7);
+
+    std::vector<int> values;
+    for (int el : list)
+        values.push_back(el);
+    REQUIRE(values == std::vector<int>{1, 2, 3, 4, 5, 6, 7});
+
+    LinkedList<int> target;
+    target.append(std::move(list));
+    REQUIRE(list.is_empty());
+    REQUIRE(target.size() == 7);
+    REQUIRE(target.front() == 1);
+    REQUIRE(target.back() == 7);
+
+    list.push_back(8);
+    REQUIRE(list.front() == 8);
+}
+
+TEST_CASE("linked lists move elements out when popping", "[linked_list]") {
+    LinkedList<std::unique_ptr<int>> list;
+    list.push_back(std::make_unique<int>(1));
+    list.push_back(std::make_unique<int>(2));
+    list.push_back(std::make_unique<int>(3));
+
+    REQUIRE(*list.pop_back() == 3);
+    REQUIRE(*list.pop_front() == 1);
+    REQUIRE(*list.back() == 2);
+    REQUIRE(*list.pop_back() == 2);
+    REQUIRE(list.is_empty());
+}
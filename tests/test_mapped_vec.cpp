@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include "mapped_vec.h"
+#include "snapshot.h"
+#include "vec.h"
+
+namespace {
+    struct Point {
+        std::int32_t x;
+        std::int32_t y;
+        double weight;
+    };
+
+    std::string temp_path(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST_CASE("maps a Vec snapshot in place", "[mapped_vec]") {
+    const std::string path = temp_path("structz_mapped_vec_points.bin");
+
+    Vec<Point> points;
+    for (std::int32_t i = 0; i < 10000; ++i)
+        points.push({i, -i, i / 4.0});
+
+    save_snapshot(points, path);
+
+    {
+        const MappedVec<Point> mapped(path);
+
+        REQUIRE(mapped.size() == 10000);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(mapped.data()) % alignof(Point) == 0);
+
+        for (std::int32_t i = 0; i < 10000; ++i) {
+            REQUIRE(mapped[i].x == i);
+            REQUIRE(mapped[i].y == -i);
+            REQUIRE(mapped[i].weight == i / 4.0);
+        }
+
+        std::int64_t sum = 0;
+        for (const Point& point : mapped)
+            sum += point.x;
+
+        REQUIRE(sum == 49995000);
+        REQUIRE_THROWS_AS(mapped[10000], std::out_of_range);
+    }
+
+    // The same file also loads as an ordinary Vec.
+    const auto loaded = load_snapshot<Vec<Point>>(path);
+    REQUIRE(loaded.size() == 10000);
+    REQUIRE(loaded[1234].weight == 1234 / 4.0);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("empty and invalid snapshots", "[mapped_vec]") {
+    const std::string path = temp_path("structz_mapped_vec_empty.bin");
+
+    save_snapshot(Vec<std::uint64_t>(), path);
+    REQUIRE(MappedVec<std::uint64_t>(path).is_empty());
+
+    save_snapshot(Vec<std::uint8_t>(3), path);
+    REQUIRE_THROWS_AS(MappedVec<std::uint64_t>(path), std::runtime_error);
+    REQUIRE(MappedVec<std::uint8_t>(path).size() == 3);
+
+    std::filesystem::resize_file(path, 8);
+    REQUIRE_THROWS_AS(MappedVec<std::uint8_t>(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(MappedVec<std::uint8_t>(path), std::runtime_error);
+}
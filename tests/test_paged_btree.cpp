@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "paged_btree.h"
+
+namespace {
+    // Removes the backing file when the test ends.
+    struct TempFile {
+        std::string path;
+
+        explicit TempFile(const std::string& name)
+            : path((std::filesystem::temp_directory_path() / name).string()) {
+            std::filesystem::remove(path);
+        }
+
+        ~TempFile() {
+            std::filesystem::remove(path);
+        }
+    };
+
+    // Small pages force a deep tree: 7 children per node for int keys and values.
+    using SmallTree = PagedBTree<int, int, std::less<int>, 128>;
+
+    std::vector<int> shuffled(const int n, const unsigned seed) {
+        std::vector<int> keys(n);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+        return keys;
+    }
+}
+
+TEST_CASE("empty tree", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_empty.db");
+    const SmallTree tree(file.path);
+
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.size() == 0);
+    REQUIRE(tree.height() == -1);
+    REQUIRE(tree.page_count() == 1);
+    REQUIRE(tree.check_properties());
+    REQUIRE(!tree.contains_key(1));
+    REQUIRE_THROWS_AS(tree.get(1), std::runtime_error);
+    REQUIRE_THROWS_AS(tree.min_key(), std::runtime_error);
+    REQUIRE(SmallTree::ORDER == 7);
+}
+
+TEST_CASE("insertion and lookup", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_insert.db");
+    SmallTree tree(file.path);
+
+    for (const int key : shuffled(2000, 1)) {
+        REQUIRE(tree.insert(key, key * 10));
+        REQUIRE(tree.check_properties());
+    }
+
+    REQUIRE(tree.size() == 2000);
+    REQUIRE(tree.min_key() == 0);
+    REQUIRE(tree.max_key() == 1999);
+
+    for (int key = 0; key < 2000; ++key)
+        REQUIRE(tree.get(key) == key * 10);
+
+    REQUIRE(!tree.contains_key(-1));
+    REQUIRE(!tree.contains_key(2000));
+
+    // Re-inserting overwrites the value without growing the tree.
+    REQUIRE(!tree.insert(7, -7));
+    REQUIRE(tree.get(7) == -7);
+    REQUIRE(tree.size() == 2000);
+}
+
+TEST_CASE("range search", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_range.db");
+    SmallTree tree(file.path);
+
+    for (const int key : shuffled(500, 2))
+        tree.insert(key * 2, key);
+
+    const auto range = tree.range_search(101, 141);
+
+    REQUIRE(range.size() == 20);
+
+    for (std::size_t i = 0; i < range.size(); ++i) {
+        REQUIRE(range[i].first == 102 + 2 * static_cast<int>(i));
+        REQUIRE(range[i].second == 51 + static_cast<int>(i));
+    }
+
+    REQUIRE(tree.range_search(-10, -1).is_empty());
+    REQUIRE(tree.range_search(0, 998).size() == 500);
+}
+
+TEST_CASE("removal", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_remove.db");
+    SmallTree tree(file.path);
+
+    const auto keys = shuffled(1500, 3);
+
+    for (const int key : keys)
+        tree.insert(key, key);
+
+    for (std::size_t i = 0; i < keys.size(); i += 2) {
+        REQUIRE(tree.remove(keys[i]));
+        REQUIRE(!tree.remove(keys[i]));
+        REQUIRE(tree.check_properties());
+    }
+
+    REQUIRE(tree.size() == 750);
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        REQUIRE(tree.contains_key(keys[i]) == (i % 2 == 1));
+
+    for (std::size_t i = 1; i < keys.size(); i += 2)
+        REQUIRE(tree.remove(keys[i]));
+
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.height() == -1);
+    REQUIRE(tree.check_properties());
+}
+
+TEST_CASE("freed pages are reused", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_reuse.db");
+    SmallTree tree(file.path);
+
+    for (const int key : shuffled(1000, 4))
+        tree.insert(key, key);
+
+    const std::size_t pages = tree.page_count();
+
+    for (int round = 0; round < 3; ++round) {
+        for (int key = 0; key < 1000; ++key)
+            tree.remove(key);
+
+        for (const int key : shuffled(1000, 5 + round))
+            tree.insert(key, key);
+
+        REQUIRE(tree.check_properties());
+    }
+
+    REQUIRE(tree.page_count() <= pages + pages / 2);
+}
+
+TEST_CASE("reopening keeps the contents", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_reopen.db");
+
+    {
+        PagedBTree<std::uint64_t, double> tree(file.path);
+
+        for (std::uint64_t key = 0; key < 20000; ++key)
+            tree.insert(key * 7919 % 20011, key / 2.0);
+
+        tree.remove(0);
+        tree.flush();
+    }
+
+    const PagedBTree<std::uint64_t, double> tree(file.path);
+
+    REQUIRE(tree.size() == 19999);
+    REQUIRE(tree.check_properties());
+    REQUIRE(!tree.contains_key(0));
+
+    for (std::uint64_t key = 1; key < 20000; ++key)
+        REQUIRE(tree.get(key * 7919 % 20011) == key / 2.0);
+}
+
+TEST_CASE("incompatible files are rejected", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_layout.db");
+
+    {
+        PagedBTree<int, int> tree(file.path);
+        tree.insert(1, 1);
+    }
+
+    REQUIRE_THROWS_AS((PagedBTree<int, double>(file.path)), std::runtime_error);
+    REQUIRE_THROWS_AS((PagedBTree<int, int, std::less<int>, 8192>(file.path)),
+                      std::runtime_error);
+
+    {
+        std::ofstream out(file.path, std::ios::trunc);
+        out << "definitely not a b-tree";
+    }
+
+    REQUIRE_THROWS_AS((PagedBTree<int, int>(file.path)), std::runtime_error);
+}
+
+TEST_CASE("move", "[paged_btree]") {
+    const TempFile file("structz_paged_btree_move.db");
+    SmallTree tree(file.path);
+
+    tree.insert(1, 2);
+
+    SmallTree moved = std::move(tree);
+    REQUIRE(moved.get(1) == 2);
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <string>
+#include "pairing_heap.h"
+
+TEST_CASE("PairingHeap basic properties", "[pairing_heap]") {
+    PairingHeap<int> heap;
+    REQUIRE(heap.size() == 0);
+    REQUIRE(heap.is_empty());
+    REQUIRE_THROWS_AS(heap.peek(), std::out_of_range);
+    REQUIRE_THROWS_AS(heap.pop(), std::out_of_range);
+}
+
+TEST_CASE("PairingHeap push and pop", "[pairing_heap]") {
+    PairingHeap<int> heap;
+
+    heap.push(5);
+    heap.push(3);
+    heap.push(7);
+    heap.push(1);
+
+    REQUIRE(heap.size() == 4);
+    REQUIRE(heap.peek() == 1);
+
+    REQUIRE(heap.pop() == 1);
+    REQUIRE(heap.pop() == 3);
+    REQUIRE(heap.pop() == 5);
+    REQUIRE(heap.pop() == 7);
+    REQUIRE(heap.is_empty());
+}
+
+TEST_CASE("PairingHeap works with many elements", "[pairing_heap]") {
+    PairingHeap<int> heap;
+    const int N = 1000;
+
+    for (int i = 0; i < N; ++i)
+        heap.push((i * 7919) % N);
+
+    REQUIRE(heap.size() == N);
+
+    for (int i = 0; i < N; ++i)
+        REQUIRE(heap.pop() == i);
+
+    REQUIRE(heap.is_empty());
+}
+
+TEST_CASE("PairingHeap with std::greater (max-heap)", "[pairing_heap][max]") {
+    PairingHeap<std::string, std::greater<>> heap;
+
+    heap.push("b");
+    heap.push("d");
+    heap.push("a");
+    heap.push("c");
+
+    REQUIRE(heap.pop() == "d");
+    REQUIRE(heap.pop() == "c");
+    REQUIRE(heap.pop() == "b");
+    REQUIRE(heap.pop() == "a");
+}
+
+TEST_CASE("PairingHeap merge", "[pairing_heap]") {
+    PairingHeap<int> a;
+    PairingHeap<int> b;
+
+    for (int i = 0; i < 10; i += 2)
+        a.push(i);
+
+    for (int i = 1; i < 10; i += 2)
+        b.push(i);
+
+    a.merge(std::move(b));
+    REQUIRE(a.size() == 10);
+    REQUIRE(b.is_empty());
+
+    for (int i = 0; i < 10; ++i)
+        REQUIRE(a.pop() == i);
+}
+
+TEST_CASE("PairingHeap copy and move", "[pairing_heap]") {
+    PairingHeap<int> heap;
+    heap.push(3);
+    heap.push(1);
+    heap.push(2);
+    heap.pop();
+    heap.push(0);
+
+    PairingHeap<int> copy(heap);
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy.pop() == 0);
+    REQUIRE(copy.pop() == 2);
+    REQUIRE(copy.pop() == 3);
+
+    REQUIRE(heap.size() == 3);
+    REQUIRE(heap.peek() == 0);
+
+    PairingHeap<int> moved(std::move(heap));
+    REQUIRE(moved.size() == 3);
+    REQUIRE(heap.is_empty());
+
+    moved.clear();
+    REQUIRE(moved.is_empty());
+}
+
+TEST_CASE("PairingHeap keeps a stateful comparator", "[pairing_heap]") {
+    // Orders by distance to a pivot chosen at run time.
+    struct ClosestTo {
+        int pivot = 0;
+
+        bool operator()(const int a, const int b) const {
+            return std::abs(a - pivot) < std::abs(b - pivot);
+        }
+    };
+
+    PairingHeap<int, ClosestTo> heap(ClosestTo{10});
+    for (int value : {0, 6, 13, 20, 11})
+        heap.push(value);
+
+    PairingHeap<int, ClosestTo> copy(heap);
+    REQUIRE(copy.pop() == 11);
+    REQUIRE(copy.pop() == 13);
+    REQUIRE(copy.pop() == 6);
+
+    PairingHeap<int, ClosestTo> assigned;
+    assigned = heap;
+    REQUIRE(assigned.pop() == 11);
+    REQUIRE(assigned.pop() == 13);
+
+    PairingHeap<int, ClosestTo> moved;
+    moved = std::move(heap);
+    moved.push(8);
+    REQUIRE(moved.pop() == 11);
+    REQUIRE(moved.pop() == 8);
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "persistent_avl_tree.h"
+
+TEST_CASE("basic operations", "[persistent_avl_tree]") {
+    PersistentAvlTree<int, std::string> tree;
+
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.height() == -1);
+    REQUIRE(tree.begin() == tree.end());
+
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(tree.insert(i, std::to_string(i)));
+
+    REQUIRE(tree.size() == 100);
+    REQUIRE(tree.height() <= 7);
+    REQUIRE(tree.check_properties());
+
+    REQUIRE(!tree.insert(5, "five"));
+    REQUIRE(tree.get(5) == "five");
+    REQUIRE(tree.size() == 100);
+
+    REQUIRE(tree.remove(50));
+    REQUIRE(!tree.remove(50));
+    REQUIRE(!tree.contains(50));
+    REQUIRE(tree.find(50) == nullptr);
+    REQUIRE(*tree.find(51) == "51");
+    REQUIRE_THROWS_AS(tree.get(50), std::out_of_range);
+    REQUIRE(tree.size() == 99);
+    REQUIRE(tree.check_properties());
+
+    int expected = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it) {
+        if (expected == 50)
+            ++expected;
+
+        REQUIRE(it.key() == expected);
+        REQUIRE((*it).first == expected);
+        ++expected;
+    }
+
+    tree.clear();
+    REQUIRE(tree.is_empty());
+}
+
+TEST_CASE("snapshots are isolated from later updates", "[persistent_avl_tree]") {
+    PersistentAvlTree<int, int> tree;
+    std::vector<PersistentAvlTree<int, int>> snapshots;
+    std::vector<std::map<int, int>> expected;
+
+    std::map<int, int> model;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 3000; ++step) {
+        const int key = static_cast<int>(rng() % 500);
+
+        if (rng() % 3 == 0) {
+            REQUIRE(tree.remove(key) == (model.erase(key) == 1));
+        } else {
+            REQUIRE(tree.insert(key, step) == (model.count(key) == 0));
+            model[key] = step;
+        }
+
+        if (step % 300 == 0) {
+            snapshots.push_back(tree.snapshot());
+            expected.push_back(model);
+        }
+    }
+
+    for (std::size_t i = 0; i < snapshots.size(); ++i) {
+        const auto& snapshot = snapshots[i];
+
+        REQUIRE(snapshot.check_properties());
+        REQUIRE(snapshot.size() == expected[i].size());
+
+        auto it = snapshot.begin();
+        for (const auto& [key, value] : expected[i]) {
+            REQUIRE(it.key() == key);
+            REQUIRE(it.value() == value);
+            ++it;
+        }
+
+        REQUIRE(it == snapshot.end());
+    }
+}
+
+TEST_CASE("iterators keep their version alive", "[persistent_avl_tree]") {
+    auto tree = std::make_unique<PersistentAvlTree<int, std::string>>();
+
+    for (int i = 0; i < 10; ++i)
+        tree->insert(i, std::string(20, static_cast<char>('a' + i)));
+
+    auto it = tree->begin();
+    const auto end = tree->end();
+
+    tree->clear();
+    tree.reset();
+
+    int count = 0;
+    for (; it != end; ++it)
+        REQUIRE(it.value() == std::string(20, static_cast<char>('a' + count++)));
+
+    REQUIRE(count == 10);
+}
+
+TEST_CASE("readers iterate snapshots while the writer updates", "[persistent_avl_tree]") {
+    PersistentAvlTree<int, int> tree;
+
+    for (int i = 0; i < 2000; ++i)
+        tree.insert(i, i);
+
+    std::atomic<bool> failed = false;
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([snapshot = tree.snapshot(), &failed] {
+            for (int round = 0; round < 20; ++round) {
+                int expected = 0;
+
+                for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+                    if (it.key() != expected || it.value() != expected)
+                        failed = true;
+
+                    ++expected;
+                }
+
+                if (expected != 2000)
+                    failed = true;
+            }
+        });
+    }
+
+    for (int i = 0; i < 2000; i += 2)
+        tree.remove(i);
+
+    for (int i = 0; i < 2000; ++i)
+        tree.insert(i + 5000, -i);
+
+    for (auto& reader : readers)
+        reader.join();
+
+    REQUIRE(!failed);
+    REQUIRE(tree.size() == 3000);
+    REQUIRE(tree.check_properties());
+}
@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "radix_heap.h"
+
+TEST_CASE("RadixHeap basic properties", "[radix_heap]") {
+    RadixHeap<std::uint32_t> heap;
+    REQUIRE(heap.size() == 0);
+    REQUIRE(heap.is_empty());
+    REQUIRE_THROWS_AS(heap.peek(), std::out_of_range);
+    REQUIRE_THROWS_AS(heap.pop(), std::out_of_range);
+}
+
+TEST_CASE("RadixHeap push and pop", "[radix_heap]") {
+    RadixHeap<std::uint32_t> heap;
+
+    heap.push(5);
+    heap.push(3);
+    heap.push(7);
+    heap.push(1);
+    heap.push(3);
+
+    REQUIRE(heap.size() == 5);
+    REQUIRE(heap.peek() == 1);
+
+    REQUIRE(heap.pop() == 1);
+    REQUIRE(heap.pop() == 3);
+    REQUIRE(heap.pop() == 3);
+    REQUIRE(heap.pop() == 5);
+    REQUIRE(heap.pop() == 7);
+    REQUIRE(heap.is_empty());
+}
+
+TEST_CASE("RadixHeap monotone workload", "[radix_heap]") {
+    RadixHeap<std::uint64_t> heap;
+    heap.push(0);
+
+    // Dijkstra-like: every popped key pushes a few larger keys.
+    std::uint64_t last = 0;
+    std::size_t popped = 0;
+
+    while (!heap.is_empty() && popped < 1000) {
+        const std::uint64_t key = heap.pop();
+        REQUIRE(key >= last);
+        last = key;
+        ++popped;
+
+        heap.push(key + 1);
+        heap.push(key + 17);
+        heap.push(key + (std::uint64_t{1} << 40));
+    }
+
+    REQUIRE(popped == 1000);
+}
+
+TEST_CASE("RadixHeap rejects keys below the last minimum", "[radix_heap]") {
+    RadixHeap<std::uint16_t> heap;
+    heap.push(10);
+    heap.push(20);
+
+    REQUIRE(heap.pop() == 10);
+    REQUIRE_THROWS_AS(heap.push(5), std::invalid_argument);
+
+    heap.push(10);
+    REQUIRE(heap.pop() == 10);
+    REQUIRE(heap.pop() == 20);
+
+    heap.clear();
+    heap.push(0);
+    REQUIRE(heap.peek() == 0);
+}
+
+TEST_CASE("RadixHeap carries a value with each key", "[radix_heap]") {
+    RadixHeap<std::uint32_t, std::string> heap;
+
+    heap.push(30, "thirty");
+    heap.push(10, "ten");
+    heap.push(20, "twenty");
+
+    REQUIRE(heap.peek().first == 10);
+    REQUIRE(heap.peek().second == "ten");
+
+    const auto [key, value] = heap.pop();
+    REQUIRE(key == 10);
+    REQUIRE(value == "ten");
+
+    heap.push(25, "twenty-five");
+    REQUIRE(heap.pop() == std::pair<std::uint32_t, std::string>{20, "twenty"});
+    REQUIRE(heap.pop().second == "twenty-five");
+    REQUIRE(heap.pop().second == "thirty");
+    REQUIRE(heap.is_empty());
+}
+
+TEST_CASE("RadixHeap drives Dijkstra", "[radix_heap]") {
+    // Shortest paths on a ring with chords; checked against Bellman-Ford style relaxation.
+    constexpr std::size_t n = 200;
+    std::vector<std::vector<std::pair<std::size_t, std::uint32_t>>> graph(n);
+    std::mt19937 rng(4);
+
+    for (std::size_t v = 0; v < n; ++v) {
+        graph[v].push_back({(v + 1) % n, 1 + static_cast<std::uint32_t>(rng() % 100)});
+        graph[v].push_back({rng() % n, 1 + static_cast<std::uint32_t>(rng() % 1000)});
+    }
+
+    constexpr std::uint32_t infinity = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> dist(n, infinity);
+    RadixHeap<std::uint32_t, std::size_t> heap;
+
+    dist[0] = 0;
+    heap.push(0, 0);
+
+    while (!heap.is_empty()) {
+        const auto [d, v] = heap.pop();
+        if (d != dist[v])
+            continue;
+
+        for (const auto& [to, weight] : graph[v]) {
+            if (d + weight < dist[to]) {
+                dist[to] = d + weight;
+                heap.push(dist[to], to);
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> expected(n, infinity);
+    expected[0] = 0;
+
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        for (std::size_t v = 0; v < n; ++v) {
+            if (expected[v] == infinity)
+                continue;
+
+            for (const auto& [to, weight] : graph[v]) {
+                if (expected[v] + weight < expected[to]) {
+                    expected[to] = expected[v] + weight;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    REQUIRE(dist == expected);
+}
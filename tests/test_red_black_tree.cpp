@@ -1,4 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include "red_black_tree.h"
 
 TEST_CASE("Empty tree properties") {
@@ -123,3 +130,266 @@ TEST_CASE("Assignment operators work correctly") {
         REQUIRE(b.contains(1));
     }
 }
+
+TEST_CASE("Order statistics with SubtreeSize") {
+    RedBlackTree<int, int, std::less<int>, SubtreeSize> tree;
+    std::vector<int> keys;
+
+    std::mt19937 rng(5);
+    for (int i = 0; i < 2000; ++i) {
+        const int key = static_cast<int>(rng() % 5000);
+
+        if (tree.insert(key, key * 2))
+            keys.push_back(key);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    REQUIRE(tree.summary()->size == keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(tree.select(i).first == keys[i]);
+        REQUIRE(tree.select(i).second == keys[i] * 2);
+        REQUIRE(tree.rank(keys[i]) == i);
+        REQUIRE(tree.rank(keys[i] + 1) == i + 1);
+    }
+
+    REQUIRE_THROWS_AS(tree.select(keys.size()), std::out_of_range);
+
+    for (int lo = -10; lo < 5010; lo += 131) {
+        for (int hi = lo - 5; hi < 5010; hi += 257) {
+            const auto expected = std::count_if(keys.begin(), keys.end(), [&](int k) {
+                return lo <= k && k <= hi;
+            });
+
+            REQUIRE(tree.count_range(lo, hi) == static_cast<std::size_t>(expected));
+        }
+    }
+
+    const auto copy = tree;
+    REQUIRE(copy.select(7).first == keys[7]);
+}
+
+TEST_CASE("Nodes store no parent pointer, color or height") {
+    struct Bare {
+        int key;
+        int value;
+        void* left;
+        void* right;
+    };
+
+    REQUIRE(RedBlackTree<int, int>::NODE_SIZE == sizeof(Bare));
+}
+
+TEST_CASE("Removal keeps the tree balanced") {
+    RedBlackTree<int, int> tree;
+    std::vector<int> keys(3000);
+    for (int i = 0; i < 3000; ++i)
+        keys[i] = i;
+
+    std::mt19937 rng(11);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    for (const int key : keys)
+        REQUIRE(tree.insert(key, -key));
+
+    REQUIRE(tree.check_properties());
+
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    for (std::size_t i = 0; i < keys.size(); i += 2) {
+        REQUIRE(tree.remove(keys[i]));
+        REQUIRE_FALSE(tree.remove(keys[i]));
+        REQUIRE(tree.check_properties());
+    }
+
+    REQUIRE(tree.size() == 1500);
+    REQUIRE(tree.height() <= 2 * 11);
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(tree.contains(keys[i]) == (i % 2 == 1));
+
+        if (i % 2 == 1)
+            REQUIRE(tree.get(keys[i]) == -keys[i]);
+    }
+
+    for (std::size_t i = 1; i < keys.size(); i += 2)
+        REQUIRE(tree.remove(keys[i]));
+
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.height() == -1);
+    REQUIRE_FALSE(tree.remove(0));
+}
+
+TEST_CASE("Iteration is in key order") {
+    RedBlackTree<int, std::string> tree;
+    REQUIRE(tree.begin() == tree.end());
+
+    for (int i = 0; i < 100; ++i)
+        tree.insert((i * 37) % 100, std::to_string(i));
+
+    int expected = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it) {
+        REQUIRE(it.key() == expected);
+        it.value() += "!";
+        ++expected;
+    }
+
+    REQUIRE(expected == 100);
+
+    const auto& const_tree = tree;
+    expected = 0;
+    for (const auto [key, value] : const_tree) {
+        REQUIRE(key == expected);
+        REQUIRE(value.back() == '!');
+        ++expected;
+    }
+}
+
+TEST_CASE("Order statistics survive removal") {
+    RedBlackTree<int, int, std::less<int>, SubtreeSize> tree;
+
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i, i);
+
+    for (int i = 0; i < 1000; i += 3)
+        tree.remove(i);
+
+    REQUIRE(tree.check_properties());
+    REQUIRE(tree.summary()->size == tree.size());
+
+    std::size_t index = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++index) {
+        REQUIRE(tree.select(index).first == it.key());
+        REQUIRE(tree.rank(it.key()) == index);
+    }
+
+    REQUIRE(tree.count_range(0, 8) == 6);
+}
+
+TEST_CASE("Red-black split and join") {
+    using Tree = RedBlackTree<int, int, std::less<int>, SubtreeSize>;
+
+    for (int pivot = -5; pivot < 310; pivot += 7) {
+        Tree tree;
+        for (int i = 0; i < 300; ++i)
+            tree.insert(i, i * 2);
+
+        auto upper = tree.split(pivot);
+        const auto expected_upper = static_cast<std::size_t>(std::clamp(300 - pivot, 0, 300));
+
+        REQUIRE(tree.check_properties());
+        REQUIRE(upper.check_properties());
+        REQUIRE(upper.size() == expected_upper);
+        REQUIRE(tree.size() == 300 - expected_upper);
+
+        if (!upper.is_empty()) {
+            REQUIRE(upper.summary()->size == expected_upper);
+            REQUIRE(upper.select(0).first == std::max(pivot, 0));
+        }
+
+        auto joined = Tree::join(std::move(tree), std::move(upper));
+
+        REQUIRE(joined.check_properties());
+        REQUIRE(joined.size() == 300);
+        REQUIRE(joined.rank(150) == 150);
+        REQUIRE(tree.is_empty());
+        REQUIRE(upper.is_empty());
+    }
+
+    RedBlackTree<int, int> low;
+    RedBlackTree<int, int> high;
+    low.insert(5, 5);
+    high.insert(5, 5);
+
+    REQUIRE_THROWS_AS((RedBlackTree<int, int>::join(low, high)), std::invalid_argument);
+
+    // Trees of very different heights.
+    for (int i = 6; i < 5000; ++i)
+        high.insert(i, i);
+
+    high.remove(5);
+    const auto joined = RedBlackTree<int, int>::join(low, high);
+
+    REQUIRE(joined.check_properties());
+    REQUIRE(joined.size() == 4995);
+}
+
+TEST_CASE("Red-black set operations") {
+    std::mt19937 rng(42);
+
+    for (int round = 0; round < 20; ++round) {
+        const int range = 50 + round * 400;
+        std::map<int, int> a_model;
+        std::map<int, int> b_model;
+        RedBlackTree<int, int> a;
+        RedBlackTree<int, int> b;
+
+        for (int i = 0; i < range / (1 + round % 4); ++i) {
+            const int key = static_cast<int>(rng() % range);
+            a.insert(key, key);
+            a_model[key] = key;
+        }
+
+        for (int i = 0; i < range / (1 + round % 3); ++i) {
+            const int key = static_cast<int>(rng() % range);
+            b.insert(key, -key);
+            b_model[key] = -key;
+        }
+
+        const auto execution = round % 2 == 0 ? Execution::Sequential : Execution::Parallel;
+
+        auto united = a;
+        united.union_with(b, execution);
+        auto united_model = b_model;
+        united_model.insert(a_model.begin(), a_model.end());
+
+        auto common = a;
+        common.intersect_with(b, execution);
+
+        auto rest = a;
+        rest.difference_with(b, execution);
+
+        REQUIRE(united.check_properties());
+        REQUIRE(common.check_properties());
+        REQUIRE(rest.check_properties());
+        REQUIRE(united.size() == united_model.size());
+
+        std::size_t common_size = 0;
+
+        for (const auto& [key, value] : united_model)
+            REQUIRE(united.get(key) == value);
+
+        for (const auto& [key, value] : a_model) {
+            const bool shared = b_model.count(key) != 0;
+
+            REQUIRE(common.contains(key) == shared);
+            REQUIRE(rest.contains(key) == !shared);
+
+            if (shared) {
+                REQUIRE(common.get(key) == value);
+                ++common_size;
+            }
+        }
+
+        REQUIRE(common.size() == common_size);
+        REQUIRE(rest.size() == a_model.size() - common_size);
+    }
+}
+
+TEST_CASE("Red-black parallel union of large trees") {
+    RedBlackTree<int, int, std::less<int>, SubtreeSize> evens;
+    RedBlackTree<int, int, std::less<int>, SubtreeSize> thirds;
+
+    for (int i = 0; i < 60000; ++i) {
+        evens.insert(i * 2, i);
+        thirds.insert(i * 3, i);
+    }
+
+    evens.union_with(std::move(thirds), Execution::Parallel);
+
+    REQUIRE(thirds.is_empty());
+    REQUIRE(evens.check_properties());
+    REQUIRE(evens.size() == 60000 + 60000 - 20000);
+    REQUIRE(evens.summary()->size == evens.size());
+    REQUIRE(evens.select(3).first == 4);
+}
@@ -0,0 +1,435 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "avl_tree.h"
+#include "binary_heap.h"
+#include "binary_io.h"
+#include "bs_tree.h"
+#include "btree.h"
+#include "circular_list.h"
+#include "doubly_linked_list.h"
+#include "hash_map.h"
+#include "hash_set.h"
+#include "linked_list.h"
+#include "queue.h"
+#include "red_black_tree.h"
+#include "snapshot.h"
+#include "stack.h"
+#include "trie.h"
+#include "trie_map.h"
+#include "unrolled_list.h"
+#include "vec.h"
+
+namespace {
+    template<typename Container>
+    Container round_trip(const Container& container) {
+        std::stringstream stream;
+
+        BinaryWriter writer(stream);
+        container.serialize(writer);
+
+        BinaryReader reader(stream);
+        Container result = Container::deserialize(reader);
+
+        REQUIRE(reader.position() == writer.position());
+        return result;
+    }
+}
+
+TEST_CASE("values", "[serialization]") {
+    std::stringstream stream;
+    BinaryWriter writer(stream);
+
+    writer.write(std::uint8_t{7});
+    writer.write(3.5);
+    writer.write(std::string("hello"));
+    writer.write(std::pair<int, std::string>{-1, "pair"});
+    writer.align(8);
+
+    REQUIRE(writer.position() % 8 == 0);
+
+    BinaryReader reader(stream);
+
+    REQUIRE(reader.read<std::uint8_t>() == 7);
+    REQUIRE(reader.read<double>() == 3.5);
+    REQUIRE(reader.read<std::string>() == "hello");
+    REQUIRE(reader.read<std::pair<int, std::string>>() == std::pair<int, std::string>{-1, "pair"});
+
+    reader.align(8);
+    REQUIRE(reader.position() == writer.position());
+    REQUIRE_THROWS_AS(reader.read<int>(), std::runtime_error);
+}
+
+TEST_CASE("vec", "[serialization]") {
+    Vec<int> numbers;
+    for (int i = 0; i < 1000; ++i)
+        numbers.push(i * i);
+
+    REQUIRE(round_trip(numbers) == numbers);
+    REQUIRE(round_trip(Vec<int>()).is_empty());
+
+    const Vec<std::string> words = {"", "one", "two", "three"};
+    REQUIRE(round_trip(words) == words);
+
+    const Vec<Vec<int>> nested = {{1, 2}, {}, {3}};
+    REQUIRE(round_trip(nested) == nested);
+}
+
+TEST_CASE("lists", "[serialization]") {
+    LinkedList<std::string> linked;
+    DoublyLinkedList<int> doubly;
+    CircularList<int> circular;
+    UnrolledList<std::string> unrolled;
+
+    for (int i = 0; i < 100; ++i) {
+        linked.push_front(std::to_string(i));
+        doubly.push_back(i);
+        circular.push_back(-i);
+        unrolled.push_front(std::to_string(i));
+    }
+
+    const auto linked_copy = round_trip(linked);
+    const auto doubly_copy = round_trip(doubly);
+    const auto circular_copy = round_trip(circular);
+    const auto unrolled_copy = round_trip(unrolled);
+
+    REQUIRE(linked_copy.size() == 100);
+    REQUIRE(linked_copy.front() == "99");
+    REQUIRE(linked_copy.back() == "0");
+
+    int expected = 0;
+    for (const int value : doubly_copy)
+        REQUIRE(value == expected++);
+
+    expected = 0;
+    for (const int value : circular_copy)
+        REQUIRE(value == -expected++);
+
+    REQUIRE(expected == 100);
+    REQUIRE(unrolled_copy.size() == 100);
+    REQUIRE(unrolled_copy.front() == "99");
+    REQUIRE(unrolled_copy.back() == "0");
+}
+
+TEST_CASE("stack, queue and heap", "[serialization]") {
+    Stack<int> stack;
+    Queue<int> queue;
+    BinaryHeap<int> heap;
+
+    for (int i = 0; i < 50; ++i) {
+        stack.push(i);
+        queue.enqueue(i);
+        heap.push((i * 37) % 50);
+    }
+
+    for (int i = 0; i < 10; ++i)
+        queue.dequeue();
+
+    auto stack_copy = round_trip(stack);
+    auto queue_copy = round_trip(queue);
+    auto heap_copy = round_trip(heap);
+
+    for (int i = 49; i >= 0; --i)
+        REQUIRE(stack_copy.pop() == i);
+
+    REQUIRE(queue_copy.size() == 40);
+    for (int i = 10; i < 50; ++i)
+        REQUIRE(queue_copy.dequeue() == i);
+
+    queue_copy.enqueue(1);
+    REQUIRE(queue_copy.dequeue() == 1);
+
+    for (int i = 0; i < 50; ++i)
+        REQUIRE(heap_copy.pop() == i);
+}
+
+TEST_CASE("hash map and hash set", "[serialization]") {
+    HashMap<std::string, int> map;
+    HashSet<int> set;
+
+    for (int i = 0; i < 500; ++i) {
+        map.set("key" + std::to_string(i), i);
+        set.insert(i * 3);
+    }
+
+    const auto map_copy = round_trip(map);
+    const auto set_copy = round_trip(set);
+
+    REQUIRE(map_copy.size() == 500);
+    REQUIRE(set_copy.size() == 500);
+
+    for (int i = 0; i < 500; ++i) {
+        REQUIRE(map_copy.get("key" + std::to_string(i)) == i);
+        REQUIRE(set_copy.contains(i * 3));
+        REQUIRE(!set_copy.contains(i * 3 + 1));
+    }
+}
+
+TEST_CASE("binary search trees are rebuilt balanced", "[serialization]") {
+    BSTree<int, int> bst;
+    AvlTree<int, std::string> avl;
+    RedBlackTree<int, int> rbt;
+
+    // Ascending insertion degenerates the plain BST into a list.
+    for (int i = 0; i < 1000; ++i) {
+        bst.insert(i, -i);
+        avl.insert(i, std::to_string(i));
+        rbt.insert(i, 2 * i);
+    }
+
+    REQUIRE(bst.height() == 999);
+
+    auto bst_copy = round_trip(bst);
+    auto avl_copy = round_trip(avl);
+    auto rbt_copy = round_trip(rbt);
+
+    REQUIRE(bst_copy.size() == 1000);
+    REQUIRE(bst_copy.height() == 9);
+    REQUIRE(avl_copy.height() == 9);
+    REQUIRE(rbt_copy.height() == 9);
+
+    int expected = 0;
+    for (auto it = bst_copy.begin(); it != bst_copy.end(); ++it) {
+        REQUIRE((*it).first == expected);
+        REQUIRE((*it).second == -expected);
+        ++expected;
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(avl_copy.get(i) == std::to_string(i));
+        REQUIRE(rbt_copy.get(i) == 2 * i);
+    }
+
+    // The rebuilt trees keep working as usual.
+    for (int i = 1000; i < 1100; ++i) {
+        REQUIRE(avl_copy.insert(i, "new"));
+        REQUIRE(rbt_copy.insert(i, i));
+    }
+
+    REQUIRE(avl_copy.remove(500));
+    REQUIRE(!avl_copy.contains(500));
+    REQUIRE(avl_copy.size() == 1099);
+    REQUIRE(rbt_copy.size() == 1100);
+    REQUIRE(rbt_copy.height() <= 2 * 11);
+
+    REQUIRE(round_trip(AvlTree<int, int>()).is_empty());
+    REQUIRE(round_trip(RedBlackTree<int, int>()).is_empty());
+}
+
+TEST_CASE("btree bulk load", "[serialization]") {
+    for (std::size_t count = 0; count < 400; ++count) {
+        Vec<std::pair<int, int>> elements;
+        for (std::size_t i = 0; i < count; ++i)
+            elements.push({static_cast<int>(i), static_cast<int>(i) * 2});
+
+        const auto small = BTree<int, int, std::less<>, 3>::build_from_ordered_vector(elements);
+        const auto even = BTree<int, int, std::less<>, 4>::build_from_ordered_vector(elements);
+        const auto large = BTree<int, int>::build_from_ordered_vector(elements);
+
+        REQUIRE(small.check_properties());
+        REQUIRE(even.check_properties());
+        REQUIRE(large.check_properties());
+        REQUIRE(large.size() == count);
+
+        const auto copy = round_trip(large);
+
+        REQUIRE(copy.check_properties());
+        REQUIRE(copy.to_string() == large.to_string());
+    }
+
+    BTree<int, int> btree;
+    for (int i = 0; i < 1000; ++i)
+        btree.insert((i * 7) % 1000, i);
+
+    auto copy = round_trip(btree);
+
+    REQUIRE(copy.size() == 1000);
+    REQUIRE(copy.check_properties());
+
+    for (int i = 0; i < 1000; ++i)
+        REQUIRE(copy.get((i * 7) % 1000) == i);
+
+    REQUIRE(copy.insert(1000, 1000));
+    REQUIRE(copy.check_properties());
+}
+
+TEST_CASE("trie map and trie", "[serialization]") {
+    TrieMap<int> map;
+    Trie trie;
+
+    const Vec<std::string> words = {"", "a", "an", "and", "ant", "bee", "beetle", "zebra"};
+
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        map.insert(words[i], static_cast<int>(i));
+        trie.insert(words[i]);
+    }
+
+    map.insert(std::string("\0\xff", 2), -1);
+
+    const auto map_copy = round_trip(map);
+    const auto trie_copy = round_trip(trie);
+
+    REQUIRE(map_copy.size() == words.size() + 1);
+    REQUIRE(trie_copy.size() == words.size());
+
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        REQUIRE(map_copy.get(words[i]) == static_cast<int>(i));
+        REQUIRE(trie_copy.contains(words[i]));
+    }
+
+    REQUIRE(map_copy.get(std::string("\0\xff", 2)) == -1);
+    REQUIRE(!trie_copy.contains("be"));
+    REQUIRE(trie_copy.has_prefix("be"));
+}
+
+TEST_CASE("corrupt counts are rejected before allocating", "[serialization]") {
+    const auto corrupt = [](const std::uint64_t count) {
+        std::stringstream stream;
+        BinaryWriter writer(stream);
+        writer.write_size(count);
+        writer.write(1);
+        return stream;
+    };
+
+    {
+        auto stream = corrupt(std::uint64_t{1} << 60);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(Vec<int>::deserialize(reader), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(2);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(Vec<int>::deserialize(reader), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(std::uint64_t{1} << 40);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(reader.read<std::string>(), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(~std::uint64_t{0});
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS((BTree<int, int>::deserialize(reader)), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(~std::uint64_t{0});
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS((HashMap<int, int>::deserialize(reader)), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(std::uint64_t{1} << 50);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS((AvlTree<int, std::string>::deserialize(reader)), std::runtime_error);
+    }
+
+    {
+        auto stream = corrupt(~std::uint64_t{0});
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(LinkedList<int>::deserialize(reader), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(std::uint64_t{1} << 40);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(DoublyLinkedList<int>::deserialize(reader), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(std::uint64_t{1} << 40);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(CircularList<int>::deserialize(reader), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(std::uint64_t{1} << 40);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(UnrolledList<int>::deserialize(reader), std::runtime_error);
+    }
+    {
+        auto stream = corrupt(std::uint64_t{1} << 40);
+        BinaryReader reader(stream);
+        REQUIRE_THROWS_AS(TrieMap<int>::deserialize(reader), std::runtime_error);
+    }
+
+    // A count that fits is still read normally.
+    auto stream = corrupt(1);
+    BinaryReader reader(stream);
+    REQUIRE(Vec<int>::deserialize(reader) == Vec<int>{1});
+}
+
+TEST_CASE("search trees reject snapshots with keys out of order", "[serialization]") {
+    const auto snapshot = [](const Vec<int>& keys) {
+        std::stringstream stream;
+        BinaryWriter writer(stream);
+        writer.write_size(keys.size());
+
+        for (const int key : keys) {
+            writer.write(key);
+            writer.write(key * 10);
+        }
+
+        return stream;
+    };
+
+    for (const Vec<int>& keys : {Vec<int>{1, 3, 2, 4}, Vec<int>{1, 2, 2, 3}}) {
+        {
+            auto stream = snapshot(keys);
+            BinaryReader reader(stream);
+            REQUIRE_THROWS_AS((BSTree<int, int>::deserialize(reader)), std::runtime_error);
+        }
+        {
+            auto stream = snapshot(keys);
+            BinaryReader reader(stream);
+            REQUIRE_THROWS_AS((AvlTree<int, int>::deserialize(reader)), std::runtime_error);
+        }
+        {
+            auto stream = snapshot(keys);
+            BinaryReader reader(stream);
+            REQUIRE_THROWS_AS((RedBlackTree<int, int>::deserialize(reader)), std::runtime_error);
+        }
+        {
+            auto stream = snapshot(keys);
+            BinaryReader reader(stream);
+            REQUIRE_THROWS_AS((BTree<int, int>::deserialize(reader)), std::runtime_error);
+        }
+    }
+
+    // The order is the tree's own.
+    auto stream = snapshot({4, 3, 1});
+    BinaryReader reader(stream);
+    const auto tree = AvlTree<int, int, std::greater<>>::deserialize(reader);
+    REQUIRE(tree.size() == 3);
+    REQUIRE(tree.check_properties());
+}
+
+TEST_CASE("snapshot files", "[serialization]") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "structz_snapshot_test.bin").string();
+
+    HashMap<int, std::string> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i, std::string(i, 'x'));
+
+    save_snapshot(map, path);
+    const auto loaded = load_snapshot<HashMap<int, std::string>>(path);
+
+    REQUIRE(loaded.size() == 100);
+    REQUIRE(loaded.get(42) == std::string(42, 'x'));
+
+    // Truncated and foreign files are rejected.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    REQUIRE_THROWS_AS((load_snapshot<HashMap<int, std::string>>(path)), std::runtime_error);
+
+    save_snapshot(Vec<char>{'n', 'o', 'p', 'e'}, path);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        out.put('?');
+    }
+    REQUIRE_THROWS_AS(load_snapshot<Vec<char>>(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(load_snapshot<Vec<char>>(path), std::runtime_error);
+}
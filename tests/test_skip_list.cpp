@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "skip_list.h"
+
+TEST_CASE("Empty skip list") {
+    SkipList<int, std::string> list;
+
+    REQUIRE(list.is_empty());
+    REQUIRE(list.size() == 0);
+    REQUIRE_FALSE(list.contains(1));
+    REQUIRE(list.find(1) == nullptr);
+    REQUIRE_THROWS_AS(list.get(1), std::out_of_range);
+    REQUIRE_FALSE(list.remove(1));
+    REQUIRE(list.begin() == list.end());
+    REQUIRE(list.range_search(0, 10).is_empty());
+}
+
+TEST_CASE("Skip list insert, lookup and overwrite") {
+    SkipList<std::string, int> list;
+
+    REQUIRE(list.insert("b", 2));
+    REQUIRE(list.insert("a", 1));
+    REQUIRE(list.insert("c", 3));
+    REQUIRE_FALSE(list.insert("b", 20));
+
+    REQUIRE(list.size() == 3);
+    REQUIRE(list.get("b") == 20);
+    REQUIRE(*list.find("a") == 1);
+    REQUIRE_FALSE(list.contains("d"));
+
+    list.get("c") = 30;
+    REQUIRE(list.get("c") == 30);
+}
+
+TEST_CASE("Skip list iterates and scans in key order") {
+    SkipList<int, int> list;
+    std::vector<int> keys(1000);
+    for (int i = 0; i < 1000; ++i)
+        keys[i] = i * 2;
+
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+
+    for (int key : keys)
+        list.insert(key, key + 1);
+
+    int expected = 0;
+    for (auto [key, value] : list) {
+        REQUIRE(key == expected);
+        REQUIRE(value == expected + 1);
+        expected += 2;
+    }
+    REQUIRE(expected == 2000);
+
+    const auto range = list.range_search(101, 110);
+    REQUIRE(range.size() == 5);
+    REQUIRE(*range[0].first == 102);
+    REQUIRE(*range[4].first == 110);
+    REQUIRE(*range[4].second == 111);
+
+    const auto& view = list;
+    REQUIRE(view.range_search(1998, 5000).size() == 1);
+    REQUIRE(view.range_search(-10, -1).is_empty());
+}
+
+TEST_CASE("Skip list matches std::map under random operations") {
+    SkipList<int, int> list;
+    std::map<int, int> expected;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> keys(0, 499);
+
+    for (int i = 0; i < 20000; ++i) {
+        const int key = keys(rng);
+
+        switch (rng() % 3) {
+            case 0:
+                REQUIRE(list.insert(key, i) == (expected.count(key) == 0));
+                expected[key] = i;
+                break;
+            case 1:
+                REQUIRE(list.remove(key) == (expected.erase(key) == 1));
+                break;
+            default:
+                REQUIRE(list.contains(key) == (expected.count(key) == 1));
+                break;
+        }
+    }
+
+    REQUIRE(list.size() == expected.size());
+
+    auto it = expected.begin();
+    for (auto [key, value] : list) {
+        REQUIRE(key == it->first);
+        REQUIRE(value == it->second);
+        ++it;
+    }
+    REQUIRE(it == expected.end());
+}
+
+TEST_CASE("Skip list copy, move and clear") {
+    SkipList<int, std::string> list;
+
+    for (int i = 0; i < 100; ++i)
+        list.insert(i, std::to_string(i));
+
+    SkipList<int, std::string> copy = list;
+    REQUIRE(copy.remove(50));
+    REQUIRE(list.contains(50));
+    REQUIRE(copy.size() == 99);
+    REQUIRE(copy.get(99) == "99");
+
+    SkipList<int, std::string> moved = std::move(copy);
+    REQUIRE(moved.size() == 99);
+    REQUIRE_FALSE(moved.contains(50));
+
+    list = moved;
+    REQUIRE(list.size() == 99);
+    REQUIRE(list.insert(50, "fifty"));
+
+    list.clear();
+    REQUIRE(list.is_empty());
+    REQUIRE(list.begin() == list.end());
+    REQUIRE(list.insert(1, "one"));
+}
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "avl_tree.h"
+#include "splay_tree.h"
+
+namespace {
+    std::size_t g_calls = 0;
+
+    struct CountingLess {
+        bool operator()(const int a, const int b) const {
+            ++g_calls;
+            return a < b;
+        }
+    };
+}
+
+TEST_CASE("Empty splay tree") {
+    SplayTree<int, std::string> tree;
+
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.size() == 0);
+    REQUIRE(tree.height() == -1);
+    REQUIRE(tree.root_key() == nullptr);
+    REQUIRE_FALSE(tree.contains(1));
+    REQUIRE(tree.find(1) == nullptr);
+    REQUIRE_THROWS_AS(tree.get(1), std::out_of_range);
+    REQUIRE_FALSE(tree.remove(1));
+    REQUIRE(tree.begin() == tree.end());
+}
+
+TEST_CASE("Splay tree insert, lookup and overwrite") {
+    SplayTree<int, std::string> tree;
+
+    REQUIRE(tree.insert(5, "five"));
+    REQUIRE(tree.insert(3, "three"));
+    REQUIRE(tree.insert(8, "eight"));
+    REQUIRE_FALSE(tree.insert(3, "THREE"));
+
+    REQUIRE(tree.size() == 3);
+    REQUIRE(tree.get(3) == "THREE");
+    REQUIRE(tree.get(8) == "eight");
+    REQUIRE_FALSE(tree.contains(4));
+    REQUIRE(tree.check_properties());
+}
+
+TEST_CASE("Accessed keys move to the root") {
+    SplayTree<int, int> tree;
+
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i, i);
+
+    REQUIRE(*tree.root_key() == 99);
+
+    REQUIRE(tree.get(42) == 42);
+    REQUIRE(*tree.root_key() == 42);
+
+    REQUIRE(tree.contains(7));
+    REQUIRE(*tree.root_key() == 7);
+
+    // A miss splays the last node on the search path.
+    REQUIRE_FALSE(tree.contains(1000));
+    REQUIRE(*tree.root_key() == 99);
+
+    // Const lookups leave the shape alone.
+    const auto& view = tree;
+    REQUIRE(view.get(3) == 3);
+    REQUIRE(view.contains(50));
+    REQUIRE(*tree.root_key() == 99);
+
+    REQUIRE(tree.check_properties());
+}
+
+TEST_CASE("Sorted insertions followed by sorted lookups") {
+    SplayTree<int, int> tree;
+    constexpr int count = 100000;
+
+    for (int i = 0; i < count; ++i)
+        tree.insert(i, -i);
+
+    // The tree is now a chain, which neither lookups nor teardown may recurse along.
+    REQUIRE(tree.height() == count - 1);
+
+    for (int i = 0; i < count; ++i)
+        REQUIRE(tree.get(i) == -i);
+
+    REQUIRE(tree.check_properties());
+}
+
+TEST_CASE("Splay tree matches std::map under random operations") {
+    SplayTree<int, int> tree;
+    std::map<int, int> expected;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> keys(0, 999);
+
+    for (int i = 0; i < 20000; ++i) {
+        const int key = keys(rng);
+
+        switch (rng() % 3) {
+            case 0:
+                REQUIRE(tree.insert(key, i) == (expected.count(key) == 0));
+                expected[key] = i;
+                break;
+            case 1:
+                REQUIRE(tree.remove(key) == (expected.erase(key) == 1));
+                break;
+            default:
+                REQUIRE(tree.contains(key) == (expected.count(key) == 1));
+                break;
+        }
+    }
+
+    REQUIRE(tree.size() == expected.size());
+    REQUIRE(tree.check_properties());
+
+    auto it = expected.begin();
+    for (auto [key, value] : tree) {
+        REQUIRE(key == it->first);
+        REQUIRE(value == it->second);
+        ++it;
+    }
+    REQUIRE(it == expected.end());
+}
+
+TEST_CASE("Splay tree iterators reach the stored values") {
+    SplayTree<int, std::string> tree;
+    tree.insert(2, "two");
+    tree.insert(1, "one");
+    tree.insert(3, "three");
+
+    for (auto [key, value] : tree)
+        value += std::to_string(key);
+
+    const auto& view = tree;
+    const SplayTree<int, std::string>::const_iterator it = view.begin();
+    REQUIRE((*it).first == 1);
+    REQUIRE(it.value() == "one1");
+    REQUIRE(std::next(it).key() == 2);
+    REQUIRE(tree.get(3) == "three3");
+
+    SplayTree<int, std::string>::iterator unset;
+    REQUIRE(unset == tree.end());
+}
+
+TEST_CASE("Splay tree copy, move and clear") {
+    SplayTree<int, int> tree;
+
+    for (int i = 0; i < 50; ++i)
+        tree.insert(i, i * i);
+
+    SplayTree<int, int> copy = tree;
+    REQUIRE(copy.remove(10));
+    REQUIRE(tree.contains(10));
+    REQUIRE(copy.size() == 49);
+    REQUIRE(copy.check_properties());
+
+    SplayTree<int, int> moved = std::move(copy);
+    REQUIRE(moved.size() == 49);
+    REQUIRE(moved.get(7) == 49);
+
+    tree = moved;
+    REQUIRE(tree.size() == 49);
+    REQUIRE_FALSE(tree.contains(10));
+
+    tree.clear();
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.begin() == tree.end());
+}
+
+TEST_CASE("Zipfian lookups take fewer comparisons than in an AvlTree") {
+    SplayTree<int, int, CountingLess> splay;
+    AvlTree<int, int, CountingLess> avl;
+    constexpr int count = 10000;
+
+    std::vector<int> keys(count);
+    for (int i = 0; i < count; ++i)
+        keys[i] = i;
+
+    std::mt19937 rng(1);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    for (int key : keys) {
+        splay.insert(key, key);
+        avl.insert(key, key);
+    }
+
+    // The key of popularity rank r is looked up with probability proportional to r^-1.5.
+    std::vector<double> weights(count);
+    for (int i = 0; i < count; ++i)
+        weights[i] = std::pow(i + 1.0, -1.5);
+
+    std::discrete_distribution<int> rank(weights.begin(), weights.end());
+    std::vector<int> lookups;
+
+    for (int i = 0; i < 100000; ++i)
+        lookups.push_back(keys[rank(rng)]);
+
+    g_calls = 0;
+    for (int key : lookups)
+        REQUIRE(splay.get(key) == key);
+    const std::size_t splay_calls = g_calls;
+
+    g_calls = 0;
+    for (int key : lookups)
+        REQUIRE(avl.get(key) == key);
+    const std::size_t avl_calls = g_calls;
+
+    REQUIRE(splay_calls < avl_calls);
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "avl_tree.h"
+#include "bs_tree.h"
+#include "btree.h"
+#include "persistent_avl_tree.h"
+#include "red_black_tree.h"
+#include "static_search_tree.h"
+#include "vec.h"
+
+TEST_CASE("empty tree", "[static_search_tree]") {
+    const StaticSearchTree<int, int> tree;
+
+    REQUIRE(tree.is_empty());
+    REQUIRE(tree.size() == 0);
+    REQUIRE(!tree.contains(0));
+    REQUIRE(tree.find(0) == nullptr);
+    REQUIRE(tree.lower_bound(0).first == nullptr);
+    REQUIRE_THROWS_AS(tree.get(0), std::out_of_range);
+
+    REQUIRE(StaticSearchTree<int, int>(Vec<std::pair<int, int>>()).is_empty());
+}
+
+TEST_CASE("lookups match the sorted input", "[static_search_tree]") {
+    // Every size up to a few complete levels, to cover partially filled last levels.
+    for (int n = 1; n < 140; ++n) {
+        auto entries = Vec<std::pair<int, int>>::with_capacity(n);
+        for (int i = 0; i < n; ++i)
+            entries.push({i * 2, -i});
+
+        const StaticSearchTree<int, int> tree(entries);
+
+        REQUIRE(tree.size() == static_cast<std::size_t>(n));
+
+        for (int key = -1; key <= 2 * n; ++key) {
+            const auto [found_key, found_value] = tree.lower_bound(key);
+
+            if (key > 2 * (n - 1)) {
+                REQUIRE(found_key == nullptr);
+                REQUIRE(found_value == nullptr);
+                continue;
+            }
+
+            const int expected = key <= 0 ? 0 : (key + 1) / 2;
+
+            REQUIRE(*found_key == expected * 2);
+            REQUIRE(*found_value == -expected);
+            REQUIRE(tree.contains(key) == (key >= 0 && key % 2 == 0));
+        }
+    }
+}
+
+TEST_CASE("string keys", "[static_search_tree]") {
+    Vec<std::pair<std::string, int>> entries = {{"apple", 1}, {"banana", 2}, {"cherry", 3}};
+    const StaticSearchTree<std::string, int> tree(entries);
+
+    REQUIRE(tree.get("banana") == 2);
+    REQUIRE(*tree.lower_bound("b").first == "banana");
+    REQUIRE(*tree.lower_bound("c").first == "cherry");
+    REQUIRE(!tree.contains("date"));
+}
+
+TEST_CASE("unsorted input is rejected", "[static_search_tree]") {
+    Vec<std::pair<int, int>> unsorted = {{1, 1}, {3, 3}, {2, 2}};
+    Vec<std::pair<int, int>> duplicate = {{1, 1}, {1, 2}};
+
+    REQUIRE_THROWS_AS((StaticSearchTree<int, int>(unsorted)), std::invalid_argument);
+    REQUIRE_THROWS_AS((StaticSearchTree<int, int>(duplicate)), std::invalid_argument);
+}
+
+TEST_CASE("built from ordered containers", "[static_search_tree]") {
+    AvlTree<int, int> avl;
+    RedBlackTree<int, int> rbt;
+    BSTree<int, int> bst;
+    BTree<int, int> btree;
+    PersistentAvlTree<int, int> persistent;
+
+    std::mt19937 rng(3);
+    for (int i = 0; i < 2000; ++i) {
+        const int key = static_cast<int>(rng() % 10000);
+
+        avl.insert(key, key + 1);
+        rbt.insert(key, key + 1);
+        bst.insert(key, key + 1);
+        btree.insert(key, key + 1);
+        persistent.insert(key, key + 1);
+    }
+
+    const auto from_avl = StaticSearchTree<int, int>::from(avl);
+    const auto from_rbt = StaticSearchTree<int, int>::from(rbt);
+    const auto from_bst = StaticSearchTree<int, int>::from(bst);
+    const auto from_btree = StaticSearchTree<int, int>::from(btree);
+    const auto from_persistent = StaticSearchTree<int, int>::from(persistent);
+
+    REQUIRE(from_avl.size() == avl.size());
+    REQUIRE(from_rbt.size() == avl.size());
+    REQUIRE(from_bst.size() == avl.size());
+    REQUIRE(from_btree.size() == avl.size());
+    REQUIRE(from_persistent.size() == avl.size());
+
+    for (int key = 0; key < 10000; ++key) {
+        const bool present = avl.contains(key);
+
+        REQUIRE(from_avl.contains(key) == present);
+        REQUIRE(from_rbt.contains(key) == present);
+        REQUIRE(from_bst.contains(key) == present);
+        REQUIRE(from_btree.contains(key) == present);
+        REQUIRE(from_persistent.contains(key) == present);
+
+        if (present)
+            REQUIRE(from_btree.get(key) == key + 1);
+    }
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "top_k.h"
+
+TEST_CASE("TopK basic properties", "[top_k]") {
+    TopK<int> top(3);
+    REQUIRE(top.capacity() == 3);
+    REQUIRE(top.size() == 0);
+    REQUIRE(top.is_empty());
+    REQUIRE_FALSE(top.is_full());
+    REQUIRE_THROWS_AS(top.peek(), std::out_of_range);
+}
+
+TEST_CASE("TopK keeps the k greatest elements", "[top_k]") {
+    TopK<int> top(3);
+
+    for (int i = 0; i < 100; ++i)
+        top.push((i * 37) % 100);
+
+    REQUIRE(top.size() == 3);
+    REQUIRE(top.is_full());
+    REQUIRE(top.peek() == 97);
+
+    REQUIRE_FALSE(top.push(50));
+    REQUIRE_FALSE(top.push(97));
+    REQUIRE(top.push(98));
+
+    const Vec<int> result = top.into_sorted_vec();
+    REQUIRE(result == Vec<int>{99, 98, 98});
+    REQUIRE(top.is_empty());
+}
+
+TEST_CASE("TopK with std::greater keeps the smallest", "[top_k]") {
+    TopK<std::string, std::greater<>> top(2);
+
+    top.push("pear");
+    top.push("apple");
+    top.push("zucchini");
+    top.push("banana");
+
+    const Vec<std::string> result = top.into_sorted_vec();
+    REQUIRE(result == Vec<std::string>{"apple", "banana"});
+}
+
+TEST_CASE("TopK with k = 0 rejects everything", "[top_k]") {
+    TopK<int> top(0);
+    REQUIRE_FALSE(top.push(1));
+    REQUIRE(top.is_empty());
+}
+
+TEST_CASE("TopK merge", "[top_k]") {
+    TopK<int> a(4);
+    TopK<int> b(4);
+
+    for (int i = 0; i < 50; i += 2)
+        a.push(i);
+
+    for (int i = 1; i < 50; i += 2)
+        b.push(i);
+
+    SECTION("Copying merge") {
+        a.merge(b);
+        REQUIRE(b.size() == 4);
+        REQUIRE(a.into_sorted_vec() == Vec<int>{49, 48, 47, 46});
+    }
+
+    SECTION("Moving merge") {
+        a.merge(std::move(b));
+        REQUIRE(b.is_empty());
+        REQUIRE(a.into_sorted_vec() == Vec<int>{49, 48, 47, 46});
+    }
+
+    SECTION("Merging with itself") {
+        a.merge(a);
+        REQUIRE(a.size() == 4);
+
+        a.merge(std::move(a));
+        REQUIRE(a.into_sorted_vec() == Vec<int>{48, 46, 44, 42});
+    }
+}
+
+TEST_CASE("top_k over an iterator range", "[top_k]") {
+    const std::vector<int> values = {5, 1, 9, 3, 7, 2, 8};
+
+    REQUIRE(top_k(values.begin(), values.end(), 3) == Vec<int>{9, 8, 7});
+    REQUIRE(top_k<std::greater<>>(values.begin(), values.end(), 2) == Vec<int>{1, 2});
+    REQUIRE(top_k(values.begin(), values.end(), 10).size() == values.size());
+}
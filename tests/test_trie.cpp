@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "trie.h"
+
+TEST_CASE("Trie empty", "[trie]") {
+    const Trie trie;
+
+    REQUIRE_FALSE(trie.contains(""));
+    REQUIRE_FALSE(trie.contains("a"));
+    REQUIRE_FALSE(trie.has_prefix(""));
+}
+
+TEST_CASE("Trie insert and contains", "[trie]") {
+    Trie trie;
+    trie.insert("romane");
+    trie.insert("romanus");
+    trie.insert("romulus");
+    trie.insert("rubens");
+    trie.insert("ruber");
+    trie.insert("rubicon");
+    trie.insert("rubicundus");
+
+    REQUIRE(trie.contains("romane"));
+    REQUIRE(trie.contains("romanus"));
+    REQUIRE(trie.contains("romulus"));
+    REQUIRE(trie.contains("rubens"));
+    REQUIRE(trie.contains("ruber"));
+    REQUIRE(trie.contains("rubicon"));
+    REQUIRE(trie.contains("rubicundus"));
+
+    REQUIRE_FALSE(trie.contains("r"));
+    REQUIRE_FALSE(trie.contains("rom"));
+    REQUIRE_FALSE(trie.contains("roman"));
+    REQUIRE_FALSE(trie.contains("rubicundusx"));
+    REQUIRE_FALSE(trie.contains("rubico"));
+    REQUIRE_FALSE(trie.contains("zebra"));
+}
+
+TEST_CASE("Trie words that are prefixes of other words", "[trie]") {
+    Trie trie;
+    trie.insert("testing");
+    trie.insert("test");
+    trie.insert("tester");
+
+    REQUIRE(trie.contains("test"));
+    REQUIRE(trie.contains("tester"));
+    REQUIRE(trie.contains("testing"));
+    REQUIRE_FALSE(trie.contains("tes"));
+    REQUIRE_FALSE(trie.contains("teste"));
+
+    trie.insert("");
+    REQUIRE(trie.contains(""));
+}
+
+TEST_CASE("Trie has_prefix", "[trie]") {
+    Trie trie;
+    trie.insert("hello");
+    trie.insert("help");
+
+    REQUIRE(trie.has_prefix(""));
+    REQUIRE(trie.has_prefix("h"));
+    REQUIRE(trie.has_prefix("hel"));
+    REQUIRE(trie.has_prefix("hell"));
+    REQUIRE(trie.has_prefix("hello"));
+    REQUIRE(trie.has_prefix("help"));
+
+    REQUIRE_FALSE(trie.has_prefix("helloo"));
+    REQUIRE_FALSE(trie.has_prefix("helm"));
+    REQUIRE_FALSE(trie.has_prefix("a"));
+}
+
+TEST_CASE("Trie accepts arbitrary bytes", "[trie]") {
+    Trie trie;
+    REQUIRE(trie.insert("Hello, World"));
+    REQUIRE(trie.insert("a b"));
+    REQUIRE(trie.insert("ñandú"));
+    REQUIRE(trie.insert(std::string_view("nul\0byte", 8)));
+    REQUIRE_FALSE(trie.insert("a b"));
+
+    REQUIRE(trie.size() == 4);
+    REQUIRE(trie.contains("Hello, World"));
+    REQUIRE(trie.contains("a b"));
+    REQUIRE(trie.contains("ñandú"));
+    REQUIRE(trie.contains(std::string_view("nul\0byte", 8)));
+    REQUIRE_FALSE(trie.contains("nul"));
+    REQUIRE(trie.has_prefix("\xc3"));
+}
+
+TEST_CASE("Trie longest_prefix and find_prefix", "[trie]") {
+    Trie trie;
+    trie.insert("car");
+    trie.insert("card");
+    trie.insert("care");
+    trie.insert("cat");
+
+    REQUIRE(trie.longest_prefix("cardigan") == 4);
+    REQUIRE(trie.longest_prefix("carpet") == 3);
+    REQUIRE_FALSE(trie.longest_prefix("ca").has_value());
+
+    std::vector<std::string> words;
+    for (const auto& [word, _] : trie.find_prefix("car"))
+        words.push_back(word);
+
+    REQUIRE(words == std::vector<std::string>{"car", "card", "care"});
+}
+
+TEST_CASE("Trie remove and compact", "[trie]") {
+    Trie trie;
+    trie.insert("alpha");
+    trie.insert("alphabet");
+    trie.insert("beta");
+
+    trie.compact();
+
+    REQUIRE(trie.remove("alpha"));
+    REQUIRE_FALSE(trie.remove("alpha"));
+    REQUIRE(trie.size() == 2);
+    REQUIRE(trie.contains("alphabet"));
+    REQUIRE(trie.has_prefix("alpha"));
+    REQUIRE_FALSE(trie.contains("alpha"));
+}
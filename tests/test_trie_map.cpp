@@ -0,0 +1,244 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#include "trie_map.h"
+
+TEST_CASE("TrieMap basic properties", "[trie_map]") {
+    TrieMap<int> map;
+
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.is_empty());
+    REQUIRE_FALSE(map.contains(""));
+    REQUIRE(map.find("a") == nullptr);
+    REQUIRE_THROWS_AS(map.get("a"), std::out_of_range);
+    REQUIRE(map.begin() == map.end());
+}
+
+TEST_CASE("TrieMap insert, get and update", "[trie_map]") {
+    TrieMap<int> map;
+
+    REQUIRE(map.insert("apple", 1));
+    REQUIRE(map.insert("app", 2));
+    REQUIRE(map.insert("application", 3));
+    REQUIRE(map.insert("banana", 4));
+    REQUIRE(map.insert("", 5));
+    REQUIRE(map.size() == 5);
+
+    REQUIRE(map.get("apple") == 1);
+    REQUIRE(map.get("app") == 2);
+    REQUIRE(map.get("application") == 3);
+    REQUIRE(map.get("banana") == 4);
+    REQUIRE(map.get("") == 5);
+    REQUIRE_FALSE(map.contains("appl"));
+    REQUIRE_FALSE(map.contains("ban"));
+
+    REQUIRE_FALSE(map.insert("app", 20));
+    REQUIRE(map.size() == 5);
+    REQUIRE(map.get("app") == 20);
+
+    map.get("banana") = 40;
+    REQUIRE(*map.find("banana") == 40);
+}
+
+TEST_CASE("TrieMap keys are compared byte-wise", "[trie_map]") {
+    TrieMap<std::string> map;
+    map.insert("\xff", "high");
+    map.insert("\x01", "low");
+    map.insert("a", "mid");
+
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : map)
+        keys.push_back(key);
+
+    REQUIRE(keys == std::vector<std::string>{"\x01", "a", "\xff"});
+}
+
+TEST_CASE("TrieMap find_prefix enumerates lazily in order", "[trie_map]") {
+    TrieMap<int> map;
+    const std::vector<std::string> words = {"tea", "ten", "to", "ted", "tedious", "inn", "in"};
+
+    for (std::size_t i = 0; i < words.size(); ++i)
+        map.insert(words[i], static_cast<int>(i));
+
+    SECTION("Prefix on a node boundary") {
+        std::vector<std::pair<std::string, int>> found;
+        for (const auto& [key, value] : map.find_prefix("te"))
+            found.emplace_back(key, value);
+
+        REQUIRE(found == std::vector<std::pair<std::string, int>>{
+                             {"tea", 0}, {"ted", 3}, {"tedious", 4}, {"ten", 1}});
+    }
+
+    SECTION("Prefix ending inside an edge label") {
+        std::vector<std::string> found;
+        for (const auto& [key, value] : map.find_prefix("tedi"))
+            found.push_back(key);
+
+        REQUIRE(found == std::vector<std::string>{"tedious"});
+    }
+
+    SECTION("Missing prefix") {
+        REQUIRE(map.find_prefix("tx").is_empty());
+        REQUIRE(map.find_prefix("teda").is_empty());
+        REQUIRE_FALSE(map.has_prefix("x"));
+    }
+
+    SECTION("All keys") {
+        std::vector<std::string> found;
+        for (auto it = map.begin(); it != map.end(); ++it)
+            found.push_back(it.key());
+
+        REQUIRE(found ==
+                std::vector<std::string>{"in", "inn", "tea", "ted", "tedious", "ten", "to"});
+    }
+
+    SECTION("Values are mutable through the iterator") {
+        for (auto [key, value] : map.find_prefix("in"))
+            value += 100;
+
+        REQUIRE(map.get("in") == 106);
+        REQUIRE(map.get("inn") == 105);
+        REQUIRE(map.get("tea") == 0);
+    }
+}
+
+TEST_CASE("TrieMap longest_prefix", "[trie_map]") {
+    TrieMap<std::string> routes;
+    routes.insert("10.", "private");
+    routes.insert("10.1.", "lab");
+    routes.insert("10.1.2.", "rack");
+
+    const auto& const_routes = routes;
+
+    auto match = const_routes.longest_prefix("10.1.2.7");
+    REQUIRE(match.has_value());
+    REQUIRE(match->first == 7);
+    REQUIRE(*match->second == "rack");
+
+    match = const_routes.longest_prefix("10.1.3.1");
+    REQUIRE(match->first == 5);
+    REQUIRE(*match->second == "lab");
+
+    REQUIRE(const_routes.longest_prefix("10.2.0.1")->first == 3);
+    REQUIRE_FALSE(const_routes.longest_prefix("192.168.0.1").has_value());
+    REQUIRE_FALSE(const_routes.longest_prefix("10").has_value());
+
+    *routes.longest_prefix("10.9")->second = "other";
+    REQUIRE(routes.get("10.") == "other");
+}
+
+TEST_CASE("TrieMap copy and move", "[trie_map]") {
+    TrieMap<int> map;
+    map.insert("one", 1);
+    map.insert("only", 2);
+    map.insert("two", 3);
+
+    TrieMap<int> copy(map);
+    copy.get("one") = 10;
+    copy.insert("three", 4);
+
+    REQUIRE(map.get("one") == 1);
+    REQUIRE_FALSE(map.contains("three"));
+    REQUIRE(copy.size() == 4);
+    REQUIRE(copy.get("only") == 2);
+
+    TrieMap<int> moved(std::move(map));
+    REQUIRE(moved.size() == 3);
+    REQUIRE(map.is_empty());
+
+    moved.clear();
+    REQUIRE(moved.is_empty());
+    REQUIRE_FALSE(moved.contains("one"));
+}
+
+TEST_CASE("TrieMap remove prunes and re-compresses", "[trie_map]") {
+    TrieMap<int> map;
+    map.insert("test", 1);
+    map.insert("tester", 2);
+    map.insert("testing", 3);
+    map.insert("team", 4);
+
+    REQUIRE_FALSE(map.remove("tes"));
+    REQUIRE_FALSE(map.remove("testers"));
+    REQUIRE_FALSE(map.remove("x"));
+    REQUIRE(map.size() == 4);
+
+    REQUIRE(map.remove("tester"));
+    REQUIRE_FALSE(map.remove("tester"));
+    REQUIRE(map.size() == 3);
+    REQUIRE_FALSE(map.contains("tester"));
+    REQUIRE(map.get("test") == 1);
+    REQUIRE(map.get("testing") == 3);
+
+    REQUIRE(map.remove("test"));
+    REQUIRE(map.get("testing") == 3);
+    REQUIRE(map.has_prefix("testi"));
+    REQUIRE_FALSE(map.contains("test"));
+
+    REQUIRE(map.remove("team"));
+    REQUIRE(map.remove("testing"));
+    REQUIRE(map.is_empty());
+    REQUIRE_FALSE(map.has_prefix("t"));
+    REQUIRE(map.begin() == map.end());
+
+    map.insert("again", 5);
+    REQUIRE(map.get("again") == 5);
+}
+
+TEST_CASE("TrieMap remove the empty key", "[trie_map]") {
+    TrieMap<int> map;
+    map.insert("", 1);
+    map.insert("a", 2);
+
+    REQUIRE(map.remove(""));
+    REQUIRE_FALSE(map.contains(""));
+    REQUIRE(map.get("a") == 2);
+}
+
+TEST_CASE("TrieMap compact", "[trie_map]") {
+    TrieMap<int> map;
+    std::vector<std::string> keys;
+
+    for (int i = 0; i < 500; ++i) {
+        keys.push_back("key/" + std::to_string(i * 7919 % 1000));
+        map.insert(keys.back(), i);
+    }
+
+    map.compact();
+    REQUIRE(map.size() == 500);
+
+    for (int i = 0; i < 500; ++i)
+        REQUIRE(map.get(keys[i]) == i);
+
+    SECTION("Mutations after compaction") {
+        map.insert("key/extra", -1);
+        map.insert("key/1", -2);
+
+        for (int i = 0; i < 500; i += 2)
+            REQUIRE(map.remove(keys[i]));
+
+        REQUIRE(map.size() == 252);
+        REQUIRE(map.get("key/extra") == -1);
+
+        for (int i = 1; i < 500; i += 2)
+            REQUIRE(map.get(keys[i]) == i);
+
+        map.compact();
+        REQUIRE(map.size() == 252);
+        REQUIRE(map.get("key/1") == -2);
+    }
+
+    SECTION("Copy of a compacted map") {
+        const TrieMap<int> copy(map);
+        map.clear();
+
+        REQUIRE(copy.size() == 500);
+        REQUIRE(copy.get(keys[42]) == 42);
+    }
+
+    SECTION("Move of a compacted map") {
+        TrieMap<int> moved(std::move(map));
+        REQUIRE(moved.get(keys[7]) == 7);
+    }
+}
@@ -0,0 +1,259 @@
+#include <catch2/catch_test_macros.hpp>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include "unrolled_list.h"
+
+namespace {
+    // Has no default constructor, so the list must construct elements in place.
+    struct Labelled {
+        std::string label;
+
+        explicit Labelled(std::string label)
+            : label(std::move(label)) {}
+    };
+
+    template<typename List>
+    std::vector<int> to_vector(const List& list) {
+        return std::vector<int>(list.begin(), list.end());
+    }
+}
+
+TEST_CASE("Empty unrolled list", "[unrolledlist]") {
+    UnrolledList<int> list;
+
+    REQUIRE(list.is_empty());
+    REQUIRE(list.size() == 0);
+    REQUIRE(list.begin() == list.end());
+    REQUIRE_THROWS_AS(list.front(), std::runtime_error);
+    REQUIRE_THROWS_AS(list.back(), std::runtime_error);
+    REQUIRE_THROWS_AS(list.pop_front(), std::runtime_error);
+    REQUIRE_THROWS_AS(list.pop_back(), std::runtime_error);
+    REQUIRE_THROWS_AS(list[0], std::out_of_range);
+}
+
+TEST_CASE("Pushes at both ends span several chunks", "[unrolledlist]") {
+    UnrolledList<int, 4> list;
+
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+        list.push_front(-i - 1);
+    }
+
+    REQUIRE(list.size() == 20);
+    REQUIRE(list.front() == -10);
+    REQUIRE(list.back() == 9);
+
+    for (std::size_t i = 0; i < list.size(); ++i)
+        REQUIRE(list[i] == static_cast<int>(i) - 10);
+
+    std::vector<int> expected;
+    for (int i = -10; i < 10; ++i)
+        expected.push_back(i);
+    REQUIRE(to_vector(list) == expected);
+
+    // Walking backwards from the end.
+    auto it = list.end();
+    for (int i = 9; i >= -10; --i)
+        REQUIRE(*--it == i);
+    REQUIRE(it == list.begin());
+}
+
+TEST_CASE("Unrolled list matches std::deque", "[unrolledlist]") {
+    UnrolledList<int, 8> list;
+    std::deque<int> expected;
+    std::mt19937 rng(9);
+
+    for (int i = 0; i < 5000; ++i) {
+        switch (rng() % 5) {
+            case 0:
+                list.push_front(i);
+                expected.push_front(i);
+                break;
+            case 1:
+                list.push_back(i);
+                expected.push_back(i);
+                break;
+            case 2:
+                if (!expected.empty()) {
+                    REQUIRE(list.pop_front() == expected.front());
+                    expected.pop_front();
+                }
+                break;
+            case 3:
+                if (!expected.empty()) {
+                    REQUIRE(list.pop_back() == expected.back());
+                    expected.pop_back();
+                }
+                break;
+            default:
+                if (!expected.empty()) {
+                    const std::size_t index = rng() % expected.size();
+                    list.remove(index);
+                    expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(index));
+                }
+                break;
+        }
+
+        REQUIRE(list.size() == expected.size());
+    }
+
+    REQUIRE(to_vector(list) == std::vector<int>(expected.begin(), expected.end()));
+}
+
+TEST_CASE("Pushes keep references and iterators valid", "[unrolledlist]") {
+    UnrolledList<int, 4> list;
+    list.push_back(1);
+    list.push_back(2);
+
+    int* const first = &list.front();
+    const auto second = std::next(list.begin());
+
+    for (int i = 0; i < 100; ++i) {
+        list.push_front(-i);
+        list.push_back(100 + i);
+    }
+
+    REQUIRE(first == &list[100]);
+    REQUIRE(*first == 1);
+    REQUIRE(*second == 2);
+    REQUIRE(*std::next(second) == 100);
+
+    list.pop_front();
+    list.pop_back();
+    REQUIRE(*second == 2);
+}
+
+TEST_CASE("Remove shifts within a chunk", "[unrolledlist]") {
+    UnrolledList<int, 4> list;
+
+    for (int i = 0; i < 10; ++i)
+        list.push_back(i);
+
+    list.remove(0);
+    list.remove(4);
+    list.remove(7);
+    REQUIRE(to_vector(list) == std::vector<int>{1, 2, 3, 4, 6, 7, 8});
+
+    REQUIRE_THROWS_AS(list.remove(7), std::out_of_range);
+
+    while (!list.is_empty())
+        list.remove(list.size() / 2);
+
+    REQUIRE(list.begin() == list.end());
+    list.push_front(5);
+    REQUIRE(list.back() == 5);
+}
+
+TEST_CASE("Remove merges under-full chunks", "[unrolledlist]") {
+    UnrolledList<int, 8> list;
+    std::vector<int> expected;
+
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back(i);
+        expected.push_back(i);
+    }
+
+    std::mt19937 rng(3);
+
+    while (expected.size() > 100) {
+        const std::size_t index = rng() % expected.size();
+        list.remove(index);
+        expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    REQUIRE(to_vector(list) == expected);
+
+    // Of two neighbouring chunks, one is at least half full or they would have merged.
+    REQUIRE(list.chunk_count() <= expected.size() / 2 + 1);
+
+    list.push_front(-1);
+    list.push_back(1000);
+    REQUIRE(list.front() == -1);
+    REQUIRE(list.back() == 1000);
+    REQUIRE(list.size() == 102);
+}
+
+TEST_CASE("End of a full tail chunk", "[unrolledlist]") {
+    UnrolledList<int, 4> list;
+
+    for (int i = 0; i < 4; ++i)
+        list.push_back(i);
+
+    REQUIRE(list.chunk_count() == 1);
+    REQUIRE(std::next(list.begin(), 4) == list.end());
+    REQUIRE(std::prev(list.end()) != list.end());
+    REQUIRE(*std::prev(list.end()) == 3);
+
+    list.push_back(4);
+    REQUIRE(std::next(list.begin(), 4) != list.end());
+    REQUIRE(std::next(list.begin(), 5) == list.end());
+}
+
+TEST_CASE("Reverse unrolled list", "[unrolledlist]") {
+    UnrolledList<int, 4> list;
+
+    for (int i = 0; i < 9; ++i)
+        list.push_back(i);
+    list.push_front(-1);
+
+    list.reverse();
+    REQUIRE(to_vector(list) == std::vector<int>{8, 7, 6, 5, 4, 3, 2, 1, 0, -1});
+
+    list.push_front(9);
+    list.push_back(-2);
+    REQUIRE(list.front() == 9);
+    REQUIRE(list.back() == -2);
+    REQUIRE(list.size() == 12);
+}
+
+TEST_CASE("Unrolled list of non-trivial elements", "[unrolledlist]") {
+    UnrolledList<Labelled> list;
+
+    for (int i = 0; i < 200; ++i)
+        list.push_back(Labelled(std::to_string(i)));
+
+    UnrolledList<Labelled> copy = list;
+    REQUIRE(copy.pop_front().label == "0");
+    REQUIRE(list.front().label == "0");
+    REQUIRE(copy.size() == 199);
+
+    UnrolledList<Labelled> moved = std::move(copy);
+    REQUIRE(moved.back().label == "199");
+    REQUIRE(moved[98].label == "99");
+
+    const auto& view = moved;
+    std::size_t count = 0;
+    for (auto it = view.begin(); it != view.end(); ++it, ++count)
+        REQUIRE(it->label == std::to_string(count + 1));
+    REQUIRE(count == 199);
+
+    list = moved;
+    REQUIRE(list.size() == 199);
+
+    list.clear();
+    REQUIRE(list.is_empty());
+    list.push_front(Labelled("again"));
+    REQUIRE(list.front().label == "again");
+}
+
+TEST_CASE("for_each visits elements in order", "[unrolledlist]") {
+    UnrolledList<int, 4> list;
+
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+        list.push_front(-i - 1);
+    }
+
+    list.for_each([](int& el) { el *= 2; });
+
+    std::vector<int> seen;
+    const auto& view = list;
+    view.for_each([&](const int el) { seen.push_back(el); });
+
+    REQUIRE(seen.size() == 20);
+    for (std::size_t i = 0; i < seen.size(); ++i)
+        REQUIRE(seen[i] == 2 * (static_cast<int>(i) - 10));
+}
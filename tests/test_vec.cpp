@@ -31,6 +31,18 @@ TEST_CASE("Vec with_capacity", "[vec]") {
     REQUIRE(v[0] == 42);
 }
 
+TEST_CASE("Vec reserve", "[vec]") {
+    Vec<int> v = {1, 2, 3};
+
+    v.reserve(16);
+    REQUIRE(v.capacity() == 16);
+    REQUIRE(v.size() == 3);
+    REQUIRE(v[2] == 3);
+
+    v.reserve(4);
+    REQUIRE(v.capacity() == 16);
+}
+
 TEST_CASE("Vec copy constructor and assignment", "[vec]") {
     Vec<int> a;
     a.push(1);